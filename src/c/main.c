@@ -2,15 +2,15 @@
  * T1000 CGM Watchface
  *
  * A Pebble watchface for displaying Dexcom CGM data.
- * Displays: Time, Date, CGM value, trend arrow, delta, and 120-minute chart.
+ * Displays: Time, Date, CGM value, trend arrow, delta, and 120-minute chart
+ * (or rolling 24-hour statistics in its place).
  */
 
 #include <pebble.h>
 
 // AppMessage keys (must match appinfo.json)
-#define KEY_CGM_VALUE     0
-#define KEY_CGM_DELTA     1
-#define KEY_CGM_TREND     2
+#define KEY_CGM_VALUE     0  // mg/dL, only sent to clear it (0); readings come from the history
+#define KEY_CGM_TREND     2  // Dexcom trend index (TREND_NONE = derive from the history)
 #define KEY_CGM_TIME_AGO  3
 #define KEY_CGM_HISTORY   4
 #define KEY_CGM_ALERT     5
@@ -21,6 +21,20 @@
 #define KEY_REVERSED      10
 #define KEY_SYNC_ERROR    11
 #define KEY_MEAL_DATA     12
+#define KEY_DEFAULT_VIEW  13
+#define KEY_PREDICTION    14
+#define KEY_BANDS         15
+#define KEY_ACCOUNT       16  // Followed account the reading fields belong to (absent = 0)
+#define KEY_ACCOUNT_COUNT 17
+#define KEY_ACCOUNT_LABEL 18
+#define KEY_UNIT          19  // 0 = mg/dL, 1 = mmol/L
+#define KEY_STALE_ALARM   20  // Data age (minutes) at which the watch vibrates by itself, 0 = off
+#define KEY_ALERT_ID      21  // Alert messages carry an id; the watch sends it back as the ack
+
+// Persistent storage keys
+#define PERSIST_KEY_STATS_HEADER 1
+#define PERSIST_KEY_STATS_VALUES 2  // One key per chunk of slot values (2-4)
+#define PERSIST_KEY_STALE_ALARM  5  // StaleAlarmState
 
 // Trend arrow indices (Dexcom trend values)
 #define TREND_NONE        0
@@ -33,21 +47,58 @@
 #define TREND_DOUBLE_DOWN 7
 #define TREND_HIDE        255  // Special value: hide trend icon entirely
 
+// Readings further apart than this don't give a trend arrow (Dexcom shows none either)
+#define TREND_MAX_GAP_MINUTES 15
+
+// Sensor range (mg/dL): readings outside it are shown as LOW / HIGH
+#define GLUCOSE_LOW_LIMIT  40
+#define GLUCOSE_HIGH_LIMIT 400
+
 // Alert types
 #define ALERT_NONE        0
 #define ALERT_LOW_SOON    1
 #define ALERT_HIGH        2
+#define ALERT_RECENT_IDS  4   // Alert ids remembered so the phone's resends don't vibrate again
 
 // Chart configuration
+// History points held per account: 2 hours, or 2h40 across Emery's wider chart
+// (must match CHART_POINTS_BY_PLATFORM in index.js)
+#if defined(PBL_PLATFORM_EMERY)
+#define CHART_MAX_POINTS  32
+#else
 #define CHART_MAX_POINTS  24  // 120 minutes / 5 minutes = 24 points
+#endif
 #define CHART_DOT_SPACING 6   // Pixels between dots (was ~8px when auto-calculated)
 #define CHART_Y_MIN       40
 #define CHART_Y_MAX       300
 #define CHART_DOT_RADIUS  3
-
-// Display layout constants for Aplite (144x168)
-#define SCREEN_WIDTH      144
-#define SCREEN_HEIGHT     168
+#define CHART_FUTURE_MINUTES 30  // Reserved right of "now" when there's a prediction
+
+// Views shown in the chart area: the phone picks the default, and taps cycle through all three
+#define VIEW_CHART        0
+#define VIEW_STATS        1
+#define VIEW_LONG         2
+#define VIEW_REVERT_MS    30000  // A tapped-to view goes back to the default after this long
+
+// Long-range chart: the main account's last 12 hours from the 24-hour statistics
+// window, as 15-minute averages
+#define LONG_VIEW_HOURS           12
+#define LONG_VIEW_SLOTS_PER_POINT 3
+#define LONG_VIEW_POINTS          (LONG_VIEW_HOURS * 12 / LONG_VIEW_SLOTS_PER_POINT)
+
+// Display layout: rows are placed from the window bounds in main_window_load(). The
+// text rows keep their size on every platform and the chart gets the height that's
+// left, so a bigger screen shows more of the chart rather than a scaled-up layout.
+// Round screens inset the rows to keep their corners inside the circle.
+#define LAYOUT_VALUE_Y        24  // Glucose value row, below the time and date
+#define LAYOUT_VALUE_HEIGHT   48
+#define LAYOUT_CHART_Y        70
+#define LAYOUT_STATUS_HEIGHT  30  // Battery and time-ago row (the chart's bottom margin runs under it)
+#define LAYOUT_DELTA_WIDTH    38
+#define LAYOUT_INSET_TOP      PBL_IF_ROUND_ELSE(8, 0)
+#define LAYOUT_INSET_BOTTOM   PBL_IF_ROUND_ELSE(12, 0)
+#define LAYOUT_CHART_INSET_X  PBL_IF_ROUND_ELSE(18, 0)
+#define LAYOUT_STATUS_INSET_X PBL_IF_ROUND_ELSE(34, 0)
 
 // Window and layers
 static Window *s_main_window;
@@ -66,6 +117,9 @@ static TextLayer *s_no_data_layer;
 static Layer *s_loading_layer;
 static AppTimer *s_loading_timer;
 
+// Glucose value row (the trend arrow and delta follow the value's width)
+static GRect s_value_row;
+
 // Battery state
 static int s_battery_level = 0;
 static bool s_battery_charging = false;
@@ -96,14 +150,42 @@ static const uint32_t TREND_ICONS_BLACK[] = {
 
 // Text buffers
 static char s_time_date_buffer[24];
-static char s_cgm_value_buffer[8];
-static char s_delta_buffer[12];
-static char s_time_ago_buffer[16];
-
-// Chart data
-static int16_t s_chart_values[CHART_MAX_POINTS];
-static int16_t s_chart_minutes_ago[CHART_MAX_POINTS];  // Minutes ago for each point
-static int s_chart_count = 0;
+static char s_time_ago_buffer[20];  // "99999999h 59m ago"
+
+// Predicted trajectory points per account (parsed once per message, minutes ago are negative)
+#define MAX_PREDICTION_POINTS 6
+
+// Followed accounts: the phone sends each account's readings separately and the watch
+// keeps the latest of each, so switching accounts is a local redraw. Percentile bands,
+// meals and the 24-hour statistics belong to the main account (index 0).
+#define MAX_ACCOUNTS         3
+#define ACCOUNT_LABEL_LENGTH 10
+typedef struct {
+    char label[ACCOUNT_LABEL_LENGTH];
+    int16_t mgdl;                 // Latest reading (0 = none)
+    int16_t delta_tenths;         // Change per 5 minutes in 0.1 mg/dL, from the chart history
+    bool has_delta;
+    uint8_t trend;
+    int minutes_ago;              // -1 = no data received yet
+    time_t data_time;             // When we last received data from phone
+    bool has_sync_error;          // True when iOS app reports API error
+    int16_t chart_values[CHART_MAX_POINTS];
+    int16_t chart_minutes_ago[CHART_MAX_POINTS];  // Minutes ago for each point
+    int chart_count;
+    int16_t prediction_values[MAX_PREDICTION_POINTS];
+    int16_t prediction_minutes_ago[MAX_PREDICTION_POINTS];
+    int prediction_count;
+} Account;
+static Account s_accounts[MAX_ACCOUNTS];
+static int s_account_count = 1;
+static Account *s_account = &s_accounts[0];  // Account on screen
+
+// Time-of-day percentile bands from the phone: p10, p25, p75, p90 for each hour,
+// in mg/dL / 2 (0 = no band for that hour). Only re-sent when they change.
+#define BAND_HOURS        24
+#define BAND_PERCENTILES  4
+static uint8_t s_bands[BAND_HOURS][BAND_PERCENTILES];
+static bool s_has_bands = false;
 
 // Meal data
 #define MAX_MEALS 10
@@ -111,24 +193,94 @@ static int16_t s_meal_carbs[MAX_MEALS];
 static int16_t s_meal_minutes_ago[MAX_MEALS];
 static int s_meal_count = 0;
 
-// Current trend
+// Worst-case data message from the phone, which sizes the AppMessage inbox:
+// integer fields plus five variable ones (history, prediction, meals, bands, label).
+// Strings are "value:minutes" pairs; history minutes reach 1440 (the phone keeps 24 hours)
+#define INBOX_TUPLE_HEADER    7  // Key (4), type (1) and length (2)
+#define INBOX_HISTORY_CHARS   9  // "400:1440,"
+#define INBOX_POINT_CHARS     8  // "999:-20," (prediction and meals)
+#define INBOX_INT_FIELDS      12 // Trend, time ago, setup, sync error, settings and account fields
+#define INBOX_SIZE (1 + (INBOX_INT_FIELDS + 5) * INBOX_TUPLE_HEADER + INBOX_INT_FIELDS * 4 + \
+                    CHART_MAX_POINTS * INBOX_HISTORY_CHARS + MAX_PREDICTION_POINTS * INBOX_POINT_CHARS + \
+                    MAX_MEALS * INBOX_POINT_CHARS + BAND_HOURS * BAND_PERCENTILES + ACCOUNT_LABEL_LENGTH)
+
+// Rolling 24-hour statistics
+// One slot per 5-minute reading in a ring buffer, with running totals that are
+// updated as readings are added and retired, so nothing is rescanned per reading
+#define STATS_SLOTS         288  // 24 hours / 5 minutes
+#define STATS_SLOT_SECONDS  300
+#define STATS_CHUNK_SLOTS   (PERSIST_DATA_MAX_LENGTH / sizeof(int16_t))
+#define STATS_VERSION       1
+static int16_t s_stats_values[STATS_SLOTS];  // mg/dL, 0 = no reading in slot
+static int s_stats_head = 0;                 // Slot of the newest reading
+static time_t s_stats_head_time = 0;         // Time of the head slot (0 = no readings)
+static int s_stats_count = 0;
+static int32_t s_stats_sum = 0;
+static int32_t s_stats_sum_sq = 0;           // At most 288 * 999^2, fits in 32 bits
+static int s_stats_low = 0;                  // Readings below s_low_threshold
+static int s_stats_high = 0;                 // Readings above s_high_threshold
+static uint32_t s_stats_revision = 1;        // Bumped on every change, for the views' caches
+
+typedef struct {
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t head;
+    int32_t head_time;
+} StatsHeader;
+
+// Trend icon currently loaded, and the value and delta shown next to it
 static uint8_t s_current_trend = TREND_NONE;
-
-// Time ago tracking
-static int s_last_minutes_ago = -1;  // -1 = no data received yet
-static time_t s_last_data_time = 0;   // When we last received data from phone
+static char s_cgm_value_buffer[8];
+static char s_delta_buffer[8];
 
 // Threshold settings (defaults, updated from phone)
 static int s_low_threshold = 70;
 static int s_high_threshold = 180;
+#define MAX_THRESHOLD     999   // mg/dL, bounds values from the phone
+
+// Data older than a week is shown as a week old
+#define MAX_MINUTES_AGO   (7 * 24 * 60)
+
+// Stale-data alarm: a one-shot timer for the main account's latest reading, so a dead
+// phone or suspended JS still gets noticed. It's re-armed only when a new reading arrives.
+#define STALE_ALARM_MAX_MINUTES 240
+#define STALE_ALARM_SAME_READING_S 120  // Reading times are only known to the minute
+static int s_stale_alarm_minutes = 0;          // 0 = off
+static AppTimer *s_stale_alarm_timer = NULL;
+static time_t s_stale_alarm_reading_time = 0;  // Reading the alarm is armed (or has fired) for
+
+// Saved on exit so the alarm keeps watching the same reading after a restart
+typedef struct {
+    int32_t minutes;
+    int32_t reading_time;
+} StaleAlarmState;
 
 // Display mode (false = white on black, true = black on white)
 static bool s_reversed = false;
 
+// Display units (readings arrive in mg/dL and are formatted on the watch)
+static bool s_mmol = false;
+
+// What the chart area shows by default (a VIEW_* from the phone's settings), what it shows now, and the timer that brings the default back after a tap
+static int s_default_view = VIEW_CHART;
+static int s_shown_view = VIEW_CHART;
+static AppTimer *s_view_revert_timer = NULL;
+
+// Views drawn from the statistics window, cached until it (or what they depend on) changes
+static int16_t s_long_values[LONG_VIEW_POINTS];  // Newest first, 0 = no readings
+static uint32_t s_long_revision = 0;
+static char s_stats_text[6][12];                 // Left column, then right column
+static bool s_stats_text_has_data = false;
+static uint32_t s_stats_text_revision = 0;
+static bool s_stats_text_mmol = false;
+
+// Alert ids handled most recently (0 = unused), oldest overwritten first
+static int32_t s_recent_alert_ids[ALERT_RECENT_IDS];
+static int s_recent_alert_next = 0;
+
 // Retry tracking for outbox failures
 static bool s_is_retry = false;
 static bool s_has_outbox_failure = false;  // True after retry also fails
-static bool s_has_sync_error = false;      // True when iOS app reports API error
 
 // Sync spinner state (shown during data send/receive)
 static bool s_is_syncing = false;
@@ -148,9 +300,14 @@ static AppTimer *s_loading_timeout_timer;
 #define LOADING_ANIMATION_INTERVAL 100  // ms per frame
 #define LOADING_TIMEOUT_MS 15000  // 15 seconds
 
+// Heap usage, sampled at load, on each message and on each chart draw
+// (Aplite apps have ~24 KB for code, data and heap together)
+static size_t s_heap_high_water = 0;
+static const char *s_heap_high_water_at = "";
+
 // Forward declarations
 static void update_trend_icon(uint8_t trend);
-static void update_layout_for_cgm_text(const char *cgm_text);
+static void update_layout_for_cgm_text(const char *cgm_text, bool show_delta);
 static void update_time_ago_display(void);
 static void loading_timer_callback(void *data);
 static void loading_timeout_callback(void *data);
@@ -163,6 +320,45 @@ static void start_sync_spinner(void);
 static void stop_sync_spinner(void);
 static void update_alert_visibility(void);
 
+/**
+ * Sample heap usage and track the high-water mark
+ * Only logs when a new high is reached, so it's cheap enough to call on every draw
+ */
+static void sample_heap(const char *where) {
+    size_t used = heap_bytes_used();
+    if (used <= s_heap_high_water) {
+        return;
+    }
+
+    s_heap_high_water = used;
+    s_heap_high_water_at = where;
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Heap high-water: %d bytes used, %d free (%s)",
+            (int)used, (int)heap_bytes_free(), where);
+}
+
+/**
+ * Forget an account's readings
+ */
+static void account_reset(Account *account) {
+    memset(account, 0, sizeof(*account));
+    account->trend = TREND_NONE;
+    account->minutes_ago = -1;
+}
+
+/**
+ * Current age of an account's latest reading in minutes, or -1 if it has none
+ */
+static int account_minutes_ago(const Account *account) {
+    if (account->minutes_ago < 0 || account->data_time == 0) {
+        return -1;
+    }
+    return account->minutes_ago + (int)((time(NULL) - account->data_time) / 60);
+}
+
+static bool is_main_account_shown(void) {
+    return s_account == &s_accounts[0];
+}
+
 /**
  * Apply colors based on reversed mode to all UI elements
  */
@@ -363,6 +559,7 @@ static void alert_layer_update_proc(Layer *layer, GContext *ctx) {
     };
     GPath *triangle_path = gpath_create(&triangle_path_info);
     gpath_draw_filled(ctx, triangle_path);
+    gpath_destroy(triangle_path);
 
     // Draw exclamation mark inside with background color (1px wide, centered)
     graphics_context_set_fill_color(ctx, bg_color);
@@ -385,17 +582,12 @@ static void update_alert_visibility(void) {
         return;
     }
 
-    // Calculate current data age
-    int current_minutes_ago = 0;
-    if (s_last_minutes_ago >= 0 && s_last_data_time > 0) {
-        time_t now = time(NULL);
-        int elapsed_minutes = (int)((now - s_last_data_time) / 60);
-        current_minutes_ago = s_last_minutes_ago + elapsed_minutes;
-    }
+    // Age of the data on screen
+    int current_minutes_ago = account_minutes_ago(s_account);
 
     // Show alert if data is 15+ minutes old AND we have a sync failure
     // (either outbox failure OR iOS app reported API error)
-    bool show_alert = (current_minutes_ago >= 15) && (s_has_outbox_failure || s_has_sync_error);
+    bool show_alert = (current_minutes_ago >= 15) && (s_has_outbox_failure || s_account->has_sync_error);
     layer_set_hidden(s_alert_layer, !show_alert);
 }
 
@@ -583,40 +775,60 @@ static void hide_loading_show_data(void) {
 }
 
 /**
- * Parse chart history data with timestamps
- * Format: "120:0,125:5,130:10,..." (value:minutesAgo pairs, most recent first)
+ * Append a decimal digit to a number being parsed, saturating at INT16_MAX
+ * so oversized numbers from the phone can't overflow
  */
-static void parse_chart_history(const char *history) {
-    if (history == NULL || strlen(history) == 0) {
-        s_chart_count = 0;
-        return;
+static int parse_digit(int value, char digit) {
+    value = value * 10 + (digit - '0');
+    return value > INT16_MAX ? INT16_MAX : value;
+}
+
+static int clamp_int(int value, int min, int max) {
+    return value < min ? min : (value > max ? max : value);
+}
+
+/**
+ * Parse "value:minutesAgo" pairs, e.g. "120:0,125:5,..." (minutesAgo may be negative)
+ * Pairs with a zero value are skipped. Returns the number of pairs stored.
+ */
+static int parse_value_minutes(const char *text, int16_t *values, int16_t *minutes_ago, int max_count) {
+    if (text == NULL) {
+        return 0;
     }
 
-    s_chart_count = 0;
-    const char *ptr = history;
+    int count = 0;
+    const char *ptr = text;
 
-    while (*ptr && s_chart_count < CHART_MAX_POINTS) {
-        // Parse glucose value
+    while (*ptr && count < max_count) {
+        // Parse value
         int value = 0;
         while (*ptr >= '0' && *ptr <= '9') {
-            value = value * 10 + (*ptr - '0');
+            value = parse_digit(value, *ptr);
             ptr++;
         }
 
-        // Parse minutes ago (after colon)
-        int minutes_ago = 0;
+        // Parse minutes ago (after colon), can be negative
+        int minutes = 0;
+        bool is_negative = false;
         if (*ptr == ':') {
             ptr++;
+            if (*ptr == '-') {
+                is_negative = true;
+                ptr++;
+            }
             while (*ptr >= '0' && *ptr <= '9') {
-                minutes_ago = minutes_ago * 10 + (*ptr - '0');
+                minutes = parse_digit(minutes, *ptr);
                 ptr++;
             }
+            if (is_negative) {
+                minutes = -minutes;
+            }
         }
 
         if (value > 0) {
-            s_chart_values[s_chart_count] = (int16_t)value;
-            s_chart_minutes_ago[s_chart_count] = (int16_t)minutes_ago;
-            s_chart_count++;
+            values[count] = (int16_t)value;
+            minutes_ago[count] = (int16_t)minutes;
+            count++;
         }
 
         // Skip comma
@@ -626,6 +838,17 @@ static void parse_chart_history(const char *history) {
             break;
         }
     }
+
+    return count;
+}
+
+/**
+ * Parse chart history data with timestamps
+ * Format: "120:0,125:5,130:10,..." (value:minutesAgo pairs, most recent first)
+ */
+static void parse_chart_history(Account *account, const char *history) {
+    account->chart_count = parse_value_minutes(history, account->chart_values, account->chart_minutes_ago,
+                                               CHART_MAX_POINTS);
 }
 
 /**
@@ -634,52 +857,382 @@ static void parse_chart_history(const char *history) {
  * minutesAgo can be negative for future meals
  */
 static void parse_meal_data(const char *meal_data) {
-    if (meal_data == NULL || strlen(meal_data) == 0) {
-        s_meal_count = 0;
+    s_meal_count = parse_value_minutes(meal_data, s_meal_carbs, s_meal_minutes_ago, MAX_MEALS);
+}
+
+/**
+ * Parse the predicted trajectory
+ * Format: "135:-3,131:-8,..." (value:minutesAgo pairs, negative = in the future)
+ */
+static void parse_prediction_data(Account *account, const char *prediction) {
+    account->prediction_count = parse_value_minutes(prediction, account->prediction_values,
+                                                    account->prediction_minutes_ago, MAX_PREDICTION_POINTS);
+}
+
+/**
+ * Minutes between the two latest readings in the chart history
+ * Minutes ago are rounded on the phone, so readings 5 minutes apart can arrive 4 or 6
+ * apart; gaps within a minute of a multiple of 5 snap to it.
+ */
+static int latest_gap_minutes(const Account *account) {
+    int gap = account->chart_minutes_ago[1] - account->chart_minutes_ago[0];
+    int nearest = (gap + 2) / 5 * 5;
+    if (nearest > 0 && gap >= nearest - 1 && gap <= nearest + 1) {
+        return nearest;
+    }
+    return gap;
+}
+
+/**
+ * Work out the delta from the two latest readings in the chart history, normalized
+ * to a 5-minute change in tenths of mg/dL (rounded half away from zero)
+ */
+static void update_delta(Account *account) {
+    account->has_delta = false;
+    if (account->chart_count < 2) {
         return;
     }
 
-    s_meal_count = 0;
-    const char *ptr = meal_data;
+    int gap = latest_gap_minutes(account);
+    if (gap <= 0) {
+        return;
+    }
 
-    while (*ptr && s_meal_count < MAX_MEALS) {
-        // Parse carbs value
-        int carbs = 0;
-        while (*ptr >= '0' && *ptr <= '9') {
-            carbs = carbs * 10 + (*ptr - '0');
-            ptr++;
-        }
+    int change = (account->chart_values[0] - account->chart_values[1]) * 50;
+    int rounded = (change + (change < 0 ? -gap : gap) / 2) / gap;
+    account->delta_tenths = (int16_t)clamp_int(rounded, INT16_MIN, INT16_MAX);
+    account->has_delta = true;
+}
 
-        // Parse minutes ago (after colon), can be negative
-        int minutes_ago = 0;
-        bool is_negative = false;
-        if (*ptr == ':') {
-            ptr++;
-            if (*ptr == '-') {
-                is_negative = true;
-                ptr++;
-            }
-            while (*ptr >= '0' && *ptr <= '9') {
-                minutes_ago = minutes_ago * 10 + (*ptr - '0');
-                ptr++;
-            }
-            if (is_negative) {
-                minutes_ago = -minutes_ago;
+/**
+ * Trend arrow for a delta, using Dexcom's rate bands (1, 2 and 3 mg/dL per minute)
+ * Used when the source sends no trend, as long as the readings are close together.
+ */
+static uint8_t trend_from_delta(const Account *account) {
+    if (!account->has_delta || latest_gap_minutes(account) > TREND_MAX_GAP_MINUTES) {
+        return TREND_NONE;
+    }
+
+    // Tenths of mg/dL per 5 minutes: 1 mg/dL per minute is 50
+    int delta = account->delta_tenths;
+    if (delta > 150) {
+        return TREND_DOUBLE_UP;
+    } else if (delta > 100) {
+        return TREND_UP;
+    } else if (delta > 50) {
+        return TREND_UP_45;
+    } else if (delta >= -50) {
+        return TREND_FLAT;
+    } else if (delta >= -100) {
+        return TREND_DOWN_45;
+    } else if (delta >= -150) {
+        return TREND_DOWN;
+    }
+    return TREND_DOUBLE_DOWN;
+}
+
+/**
+ * Convert a (non-negative) mg/dL amount to tenths of mmol/L, rounded to nearest
+ * (18.0182 mg/dL per mmol/L)
+ */
+static int mgdl_to_mmol_x10(int mgdl) {
+    return (mgdl * 100000 + 90091) / 180182;
+}
+
+/**
+ * Format a mg/dL amount in the display units: "142" or "7.9"
+ * Amounts are clamped to 0-MAX_THRESHOLD, so the text always fits in 8 bytes
+ */
+static void format_glucose_amount(char *buffer, size_t size, int mgdl) {
+    mgdl = clamp_int(mgdl, 0, MAX_THRESHOLD);
+    if (s_mmol) {
+        int mmol_x10 = mgdl_to_mmol_x10(mgdl);
+        snprintf(buffer, size, "%d.%d", mmol_x10 / 10, mmol_x10 % 10);
+    } else {
+        snprintf(buffer, size, "%d", mgdl);
+    }
+}
+
+/**
+ * Whether a reading is outside the sensor range (shown as LOW / HIGH, without a delta)
+ */
+static bool is_out_of_range(int mgdl) {
+    return mgdl > 0 && (mgdl < GLUCOSE_LOW_LIMIT || mgdl > GLUCOSE_HIGH_LIMIT);
+}
+
+/**
+ * Format a reading for display: "142", "7.9", "LOW", "HIGH" or "" (no reading)
+ */
+static void format_glucose(char *buffer, size_t size, int mgdl) {
+    if (mgdl <= 0) {
+        buffer[0] = '\0';
+    } else if (mgdl < GLUCOSE_LOW_LIMIT) {
+        snprintf(buffer, size, "LOW");
+    } else if (mgdl > GLUCOSE_HIGH_LIMIT) {
+        snprintf(buffer, size, "HIGH");
+    } else {
+        format_glucose_amount(buffer, size, mgdl);
+    }
+}
+
+/**
+ * Format a delta in the display units: "+4" (mg/dL) or "-0.2" (mmol/L)
+ */
+static void format_delta(char *buffer, size_t size, int delta_tenths) {
+    int magnitude = delta_tenths < 0 ? -delta_tenths : delta_tenths;
+    if (s_mmol) {
+        // Tenths of mg/dL to tenths of mmol/L
+        magnitude = (magnitude * 1000 + 9009) / 18018;
+        snprintf(buffer, size, "%c%d.%d", delta_tenths < 0 && magnitude ? '-' : '+',
+                 magnitude / 10, magnitude % 10);
+    } else {
+        magnitude = (magnitude + 5) / 10;
+        snprintf(buffer, size, "%c%d", delta_tenths < 0 && magnitude ? '-' : '+', magnitude);
+    }
+}
+
+/**
+ * Add (sign = 1) or remove (sign = -1) a reading from the running totals
+ */
+static void stats_account(int value, int sign) {
+    s_stats_count += sign;
+    s_stats_sum += sign * value;
+    s_stats_sum_sq += sign * value * value;
+    if (value < s_low_threshold) {
+        s_stats_low += sign;
+    } else if (value > s_high_threshold) {
+        s_stats_high += sign;
+    }
+}
+
+/**
+ * Replace the reading in a slot (0 clears it), keeping the totals in step
+ */
+static void stats_set_slot(int slot, int value) {
+    if (s_stats_values[slot]) {
+        stats_account(s_stats_values[slot], -1);
+    }
+    s_stats_values[slot] = (int16_t)value;
+    if (value) {
+        stats_account(value, 1);
+    }
+    s_stats_revision++;
+}
+
+/**
+ * Forget all readings
+ */
+static void stats_reset(void) {
+    s_stats_revision++;
+    memset(s_stats_values, 0, sizeof(s_stats_values));
+    s_stats_head = 0;
+    s_stats_head_time = 0;
+    s_stats_count = 0;
+    s_stats_sum = 0;
+    s_stats_sum_sq = 0;
+    s_stats_low = 0;
+    s_stats_high = 0;
+}
+
+/**
+ * Move the head forward a number of slots, retiring the readings that leave the window
+ */
+static void stats_advance(int slots) {
+    if (slots >= STATS_SLOTS) {
+        stats_reset();
+        return;
+    }
+    for (int i = 0; i < slots; i++) {
+        s_stats_head = (s_stats_head + 1) % STATS_SLOTS;
+        stats_set_slot(s_stats_head, 0);
+    }
+}
+
+/**
+ * Add a reading to the 24-hour window
+ * Every message repeats the last two hours, so readings that already have a slot are
+ * ignored; older readings only fill empty slots. A new reading costs O(1) (plus one
+ * retirement per 5 minutes elapsed).
+ */
+static void stats_add_reading(time_t reading_time, int value) {
+    value = clamp_int(value, 1, MAX_THRESHOLD);
+
+    if (s_stats_head_time == 0) {
+        s_stats_head_time = reading_time;
+        stats_set_slot(s_stats_head, value);
+        return;
+    }
+
+    // Nearest slot relative to the head (readings are ~5 minutes apart, with some jitter)
+    int32_t diff = (int32_t)(reading_time - s_stats_head_time);
+    int offset = (diff + (diff >= 0 ? STATS_SLOT_SECONDS / 2 : -STATS_SLOT_SECONDS / 2)) / STATS_SLOT_SECONDS;
+
+    if (offset > 0) {
+        stats_advance(offset);
+        s_stats_head_time = reading_time;
+        stats_set_slot(s_stats_head, value);
+    } else if (offset > -STATS_SLOTS) {
+        int slot = (s_stats_head + offset + STATS_SLOTS) % STATS_SLOTS;
+        if (s_stats_values[slot] == 0) {
+            stats_set_slot(slot, value);
+            if (offset == 0) {
+                // Head was moved on by stats_expire(); line it up with the real reading
+                s_stats_head_time = reading_time;
             }
         }
+    }
+}
 
-        if (carbs > 0) {
-            s_meal_carbs[s_meal_count] = (int16_t)carbs;
-            s_meal_minutes_ago[s_meal_count] = (int16_t)minutes_ago;
-            s_meal_count++;
+/**
+ * Retire readings that have aged out of the window while no new readings arrive
+ * The head moves in whole slots so later readings still line up with it
+ */
+static void stats_expire(time_t now) {
+    if (s_stats_head_time == 0) {
+        return;
+    }
+
+    int32_t slots = (int32_t)(now - s_stats_head_time) / STATS_SLOT_SECONDS;
+    if (slots <= 0) {
+        return;
+    }
+    if (slots >= STATS_SLOTS) {
+        stats_reset();
+        return;
+    }
+    stats_advance(slots);
+    s_stats_head_time += slots * STATS_SLOT_SECONDS;
+}
+
+/**
+ * Add an account's chart history to the 24-hour window, oldest first
+ */
+static void stats_add_history(const Account *account, time_t now) {
+    for (int i = account->chart_count - 1; i >= 0; i--) {
+        stats_add_reading(now - account->chart_minutes_ago[i] * 60, account->chart_values[i]);
+    }
+}
+
+/**
+ * Recount low/high readings after a threshold change
+ * (the only time the window is rescanned; thresholds rarely change)
+ */
+static void stats_recount_ranges(void) {
+    s_stats_revision++;
+    s_stats_low = 0;
+    s_stats_high = 0;
+    for (int i = 0; i < STATS_SLOTS; i++) {
+        int value = s_stats_values[i];
+        if (value && value < s_low_threshold) {
+            s_stats_low++;
+        } else if (value > s_high_threshold) {
+            s_stats_high++;
         }
+    }
+}
 
-        // Skip comma
-        if (*ptr == ',') {
-            ptr++;
-        } else if (*ptr != '\0') {
-            break;
+/**
+ * Integer square root (rounded down)
+ */
+static uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
         }
+        bit >>= 2;
+    }
+    return root;
+}
+
+typedef struct {
+    int count;
+    int low_pct;
+    int in_range_pct;
+    int high_pct;
+    int mean;     // mg/dL
+    int sd;       // mg/dL
+    int gmi_x10;  // Glucose management indicator, % x 10
+} StatsSummary;
+
+/**
+ * Summarize the window from the running totals
+ * Returns false if there are no readings
+ */
+static bool stats_summarize(StatsSummary *out) {
+    int n = s_stats_count;
+    if (n <= 0) {
+        return false;
+    }
+
+    out->count = n;
+    out->low_pct = (s_stats_low * 100 + n / 2) / n;
+    out->high_pct = (s_stats_high * 100 + n / 2) / n;
+    out->in_range_pct = 100 - out->low_pct - out->high_pct;
+    out->mean = (s_stats_sum + n / 2) / n;
+
+    // Population variance: (n * sum(x^2) - sum(x)^2) / n^2
+    int64_t spread = (int64_t)n * s_stats_sum_sq - (int64_t)s_stats_sum * s_stats_sum;
+    out->sd = (int)isqrt((uint32_t)(spread / ((int64_t)n * n)));
+
+    // GMI (%) = 3.31 + 0.02392 * mean mg/dL
+    out->gmi_x10 = (int)((331000LL * n + 2392LL * s_stats_sum + 5000LL * n) / (10000LL * n));
+    return true;
+}
+
+/**
+ * Restore the window saved by stats_save(), then retire what expired meanwhile
+ */
+static void stats_load(void) {
+    StatsHeader header;
+    if (persist_read_data(PERSIST_KEY_STATS_HEADER, &header, sizeof(header)) != (int)sizeof(header) ||
+        header.version != STATS_VERSION || header.head >= STATS_SLOTS) {
+        return;
+    }
+
+    for (int i = 0; i < STATS_SLOTS; i += STATS_CHUNK_SLOTS) {
+        int slots = STATS_SLOTS - i < (int)STATS_CHUNK_SLOTS ? STATS_SLOTS - i : (int)STATS_CHUNK_SLOTS;
+        int size = slots * (int)sizeof(int16_t);
+        if (persist_read_data(PERSIST_KEY_STATS_VALUES + i / STATS_CHUNK_SLOTS, &s_stats_values[i], size) != size) {
+            stats_reset();
+            return;
+        }
+    }
+
+    s_stats_head = header.head;
+    s_stats_head_time = header.head_time;
+    for (int i = 0; i < STATS_SLOTS; i++) {
+        int value = clamp_int(s_stats_values[i], 0, MAX_THRESHOLD);
+        s_stats_values[i] = 0;
+        if (value) {
+            stats_set_slot(i, value);
+        }
+    }
+    stats_expire(time(NULL));
+}
+
+/**
+ * Save the window so it survives switching away from the watchface
+ */
+static void stats_save(void) {
+    StatsHeader header = {
+        .version = STATS_VERSION,
+        .head = (uint16_t)s_stats_head,
+        .head_time = (int32_t)s_stats_head_time
+    };
+    persist_write_data(PERSIST_KEY_STATS_HEADER, &header, sizeof(header));
+
+    for (int i = 0; i < STATS_SLOTS; i += STATS_CHUNK_SLOTS) {
+        int slots = STATS_SLOTS - i < (int)STATS_CHUNK_SLOTS ? STATS_SLOTS - i : (int)STATS_CHUNK_SLOTS;
+        persist_write_data(PERSIST_KEY_STATS_VALUES + i / STATS_CHUNK_SLOTS, &s_stats_values[i],
+                           slots * sizeof(int16_t));
     }
 }
 
@@ -700,26 +1253,97 @@ static GColor get_glucose_color(int value) {
 #endif
 
 /**
- * Draw the CGM dot chart
+ * Summarize the window into the statistics view's text (rebuilt only when the
+ * window, thresholds or units change)
  */
-static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
-    GRect bounds = layer_get_bounds(layer);
+static void stats_format_text(void) {
+    s_stats_text_revision = s_stats_revision;
+    s_stats_text_mmol = s_mmol;
 
-    // Set colors based on reversed mode
-    GColor bg_color = s_reversed ? GColorWhite : GColorBlack;
-    GColor fg_color = s_reversed ? GColorBlack : GColorWhite;
+    StatsSummary stats;
+    s_stats_text_has_data = stats_summarize(&stats);
+    if (!s_stats_text_has_data) {
+        return;
+    }
 
-    // Draw background
-    graphics_context_set_fill_color(ctx, bg_color);
-    graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+    char mean[8];
+    char sd[8];
+    format_glucose_amount(mean, sizeof(mean), stats.mean);
+    format_glucose_amount(sd, sizeof(sd), stats.sd);
+    snprintf(s_stats_text[0], sizeof(s_stats_text[0]), "High %d%%", stats.high_pct);
+    snprintf(s_stats_text[1], sizeof(s_stats_text[1]), "In %d%%", stats.in_range_pct);
+    snprintf(s_stats_text[2], sizeof(s_stats_text[2]), "Low %d%%", stats.low_pct);
+    snprintf(s_stats_text[3], sizeof(s_stats_text[3]), "Avg %s", mean);
+    snprintf(s_stats_text[4], sizeof(s_stats_text[4]), "SD %s", sd);
+    int gmi_x10 = clamp_int(stats.gmi_x10, 0, 999);  // "GMI 99.9%" at most
+    snprintf(s_stats_text[5], sizeof(s_stats_text[5]), "GMI %d.%d%%", gmi_x10 / 10, gmi_x10 % 10);
+}
 
-    if (s_chart_count == 0) {
+/**
+ * Draw the 24-hour statistics in place of the chart
+ * Left column: time above, in and below range (top to bottom, like the chart);
+ * right column: mean, standard deviation and GMI
+ */
+static void stats_view_draw(GContext *ctx, GRect bounds) {
+    GColor fg_color = s_reversed ? GColorBlack : GColorWhite;
+    GFont font = fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD);
+    graphics_context_set_text_color(ctx, fg_color);
+
+    if (s_stats_text_revision != s_stats_revision || s_stats_text_mmol != s_mmol) {
+        stats_format_text();
+    }
+    if (!s_stats_text_has_data) {
+        graphics_draw_text(ctx, "No readings yet", font,
+                           GRect(bounds.origin.x, bounds.origin.y + bounds.size.h / 2 - 14, bounds.size.w, 24),
+                           GTextOverflowModeTrailingEllipsis, GTextAlignmentCenter, NULL);
         return;
     }
+    char (*left)[12] = &s_stats_text[0];
+    char (*right)[12] = &s_stats_text[3];
 
-    // Calculate chart dimensions with margins
-    int margin = 4;
-    int chart_height = bounds.size.h - (margin * 2);
+#ifdef PBL_COLOR
+    const GColor left_colors[3] = { GColorOrange, GColorGreen, GColorRed };
+#endif
+
+    int margin = 6;
+    int row_height = 22;
+    int column_width = bounds.size.w / 2 - margin;
+    // Gothic glyphs sit ~4px below the top of their box
+    int top = bounds.origin.y + (bounds.size.h - 3 * row_height) / 2 - 4;
+
+    for (int row = 0; row < 3; row++) {
+        int y = top + row * row_height;
+#ifdef PBL_COLOR
+        graphics_context_set_text_color(ctx, left_colors[row]);
+#endif
+        graphics_draw_text(ctx, left[row], font,
+                           GRect(bounds.origin.x + margin, y, column_width, row_height + 4),
+                           GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+#ifdef PBL_COLOR
+        graphics_context_set_text_color(ctx, fg_color);
+#endif
+        graphics_draw_text(ctx, right[row], font,
+                           GRect(bounds.origin.x + bounds.size.w / 2, y, column_width, row_height + 4),
+                           GTextOverflowModeTrailingEllipsis, GTextAlignmentRight, NULL);
+    }
+}
+
+/**
+ * Map a glucose value to a Y coordinate in the chart (clamped to the chart range)
+ */
+static int chart_value_to_y(int value, GRect bounds, int margin, int chart_height) {
+    value = clamp_int(value, CHART_Y_MIN, CHART_Y_MAX);
+    return bounds.origin.y + margin + chart_height -
+           ((value - CHART_Y_MIN) * chart_height / (CHART_Y_MAX - CHART_Y_MIN));
+}
+
+/**
+ * Draw the dashed low and high threshold lines across the chart
+ */
+static void draw_threshold_lines(GContext *ctx, GRect bounds, int margin, int chart_height) {
+#ifndef PBL_COLOR
+    GColor fg_color = s_reversed ? GColorBlack : GColorWhite;
+#endif
 
     // Map thresholds to Y coordinates
     int low_y = bounds.origin.y + margin + chart_height -
@@ -727,7 +1351,6 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
     int high_y = bounds.origin.y + margin + chart_height -
                  ((s_high_threshold - CHART_Y_MIN) * chart_height / (CHART_Y_MAX - CHART_Y_MIN));
 
-    // Draw dashed threshold lines
     int dash_length = 4;
     int gap_length = 3;
     for (int x = bounds.origin.x + margin; x < bounds.origin.x + bounds.size.w - margin; x += dash_length + gap_length) {
@@ -748,6 +1371,189 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
         graphics_draw_line(ctx, GPoint(x, high_y), GPoint(end_x, high_y));
 #endif
     }
+}
+
+/**
+ * Average the newest LONG_VIEW_HOURS of the statistics window into points
+ */
+static void long_view_compute(void) {
+    s_long_revision = s_stats_revision;
+    for (int i = 0; i < LONG_VIEW_POINTS; i++) {
+        int sum = 0;
+        int count = 0;
+        for (int j = 0; j < LONG_VIEW_SLOTS_PER_POINT; j++) {
+            int slot = (s_stats_head - i * LONG_VIEW_SLOTS_PER_POINT - j + STATS_SLOTS) % STATS_SLOTS;
+            if (s_stats_values[slot]) {
+                sum += s_stats_values[slot];
+                count++;
+            }
+        }
+        s_long_values[i] = (int16_t)(count ? (sum + count / 2) / count : 0);
+    }
+}
+
+/**
+ * Draw the long-range chart: a line through the 15-minute averages, broken at gaps,
+ * with the range labelled in the corner
+ */
+static void long_view_draw(GContext *ctx, GRect bounds) {
+    if (s_long_revision != s_stats_revision) {
+        long_view_compute();
+    }
+
+    GColor fg_color = s_reversed ? GColorBlack : GColorWhite;
+    int margin = 4;
+    int chart_height = bounds.size.h - (margin * 2);
+    int left_x = bounds.origin.x + margin;
+    int right_x = bounds.origin.x + bounds.size.w - margin;
+
+    draw_threshold_lines(ctx, bounds, margin, chart_height);
+
+    graphics_context_set_stroke_width(ctx, 1);
+    graphics_context_set_fill_color(ctx, fg_color);
+    GPoint previous = GPoint(0, 0);
+    bool has_previous = false;
+    for (int i = 0; i < LONG_VIEW_POINTS; i++) {
+        int value = s_long_values[i];
+        if (value == 0) {
+            has_previous = false;
+            continue;
+        }
+
+        GPoint point = GPoint(right_x - i * (right_x - left_x) / (LONG_VIEW_POINTS - 1),
+                              chart_value_to_y(value, bounds, margin, chart_height));
+#ifdef PBL_COLOR
+        graphics_context_set_stroke_color(ctx, get_glucose_color(value));
+        graphics_context_set_fill_color(ctx, get_glucose_color(value));
+#else
+        graphics_context_set_stroke_color(ctx, fg_color);
+#endif
+        if (has_previous) {
+            graphics_draw_line(ctx, previous, point);
+        } else {
+            graphics_fill_circle(ctx, point, 1);
+        }
+        previous = point;
+        has_previous = true;
+    }
+
+    char label[6];
+    snprintf(label, sizeof(label), "%dh", LONG_VIEW_HOURS);
+    graphics_context_set_text_color(ctx, fg_color);
+    graphics_draw_text(ctx, label, fonts_get_system_font(FONT_KEY_GOTHIC_14), GRect(left_x, bounds.origin.y - 2, 30, 16),
+                       GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+}
+
+/**
+ * Draw the typical range for the time of day behind the chart
+ * Bands are interpolated between hour centres, in 2px columns. Color platforms shade
+ * 10th-90th and 25th-75th percentiles; monochrome stripes 25th-75th and dots the
+ * 10th and 90th percentile edges.
+ */
+static void draw_percentile_bands(GContext *ctx, GRect bounds, int margin, int chart_height,
+                                  int now_x, int right_x) {
+    time_t now = time(NULL);
+    struct tm *local = localtime(&now);
+    int now_minute_of_day = local->tm_hour * 60 + local->tm_min;
+
+#ifdef PBL_COLOR
+    GColor outer_color = s_reversed ? GColorLightGray : GColorDarkGray;
+    GColor inner_color = s_reversed ? GColorDarkGray : GColorLightGray;
+#else
+    graphics_context_set_stroke_color(ctx, s_reversed ? GColorBlack : GColorWhite);
+    graphics_context_set_stroke_width(ctx, 1);
+#endif
+
+    for (int x = bounds.origin.x + margin; x < right_x; x += 2) {
+        // Minute of the day at this column, relative to the centre of hour 0
+        int minute = now_minute_of_day + ((x - now_x) * 5) / CHART_DOT_SPACING - 30;
+        minute = ((minute % (24 * 60)) + 24 * 60) % (24 * 60);
+        int hour = minute / 60;
+        int next_hour = (hour + 1) % BAND_HOURS;
+        int frac = minute % 60;
+
+        int y[BAND_PERCENTILES];
+        bool has_band = true;
+        for (int p = 0; p < BAND_PERCENTILES; p++) {
+            int a = s_bands[hour][p];
+            int b = s_bands[next_hour][p];
+            if (a == 0 || b == 0) {
+                has_band = false;
+                break;
+            }
+            // Linear interpolation, then back to mg/dL (the bytes are mg/dL / 2)
+            int value = ((a * (60 - frac) + b * frac) * 2) / 60;
+            y[p] = chart_value_to_y(value, bounds, margin, chart_height);
+        }
+        if (!has_band) {
+            continue;
+        }
+
+#ifdef PBL_COLOR
+        graphics_context_set_fill_color(ctx, outer_color);
+        graphics_fill_rect(ctx, GRect(x, y[3], 2, y[0] - y[3] + 1), 0, GCornerNone);
+        graphics_context_set_fill_color(ctx, inner_color);
+        graphics_fill_rect(ctx, GRect(x, y[2], 2, y[1] - y[2] + 1), 0, GCornerNone);
+#else
+        if ((x / 2) % 2 == 0) {
+            graphics_draw_line(ctx, GPoint(x, y[2]), GPoint(x, y[1]));
+        } else {
+            graphics_draw_pixel(ctx, GPoint(x, y[3]));
+            graphics_draw_pixel(ctx, GPoint(x, y[0]));
+        }
+#endif
+    }
+}
+
+/**
+ * Draw the CGM dot chart
+ */
+static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
+    GRect bounds = layer_get_bounds(layer);
+
+    // Set colors based on reversed mode
+    GColor bg_color = s_reversed ? GColorWhite : GColorBlack;
+    GColor fg_color = s_reversed ? GColorBlack : GColorWhite;
+
+    // Draw background
+    graphics_context_set_fill_color(ctx, bg_color);
+    graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+
+    sample_heap("chart");
+
+    // Statistics are only kept for the main account, other accounts always show the chart
+    int view = is_main_account_shown() ? s_shown_view : VIEW_CHART;
+    if (view == VIEW_STATS) {
+        stats_view_draw(ctx, bounds);
+        return;
+    }
+    if (view == VIEW_LONG) {
+        long_view_draw(ctx, bounds);
+        return;
+    }
+
+    const Account *account = s_account;
+    if (account->chart_count == 0) {
+        return;
+    }
+
+    // Calculate chart dimensions with margins
+    int margin = 4;
+    int chart_height = bounds.size.h - (margin * 2);
+
+    // "Now" is at the right edge, or further left to leave room for the prediction
+    int right_x = bounds.origin.x + bounds.size.w - margin;
+    int now_x = right_x;
+    if (account->prediction_count > 0) {
+        now_x -= (CHART_FUTURE_MINUTES * CHART_DOT_SPACING) / 5;
+    }
+
+    // Typical range for the time of day, behind everything else
+    if (s_has_bands && is_main_account_shown()) {
+        draw_percentile_bands(ctx, bounds, margin, chart_height, now_x, right_x);
+    }
+
+    draw_threshold_lines(ctx, bounds, margin, chart_height);
 
     // Draw dots for each data point
     // Data comes in most-recent-first, so we plot right-to-left
@@ -755,25 +1561,24 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
 
     // Calculate elapsed time since data was received to adjust positions
     int elapsed_minutes = 0;
-    if (s_last_data_time > 0) {
+    if (account->data_time > 0) {
         time_t now = time(NULL);
-        elapsed_minutes = (int)((now - s_last_data_time) / 60);
+        elapsed_minutes = (int)((now - account->data_time) / 60);
     }
 
-    for (int i = 0; i < s_chart_count; i++) {
-        int value = s_chart_values[i];
-        int original_value = value;  // Keep original for color determination
+    for (int i = 0; i < account->chart_count; i++) {
+        int value = account->chart_values[i];
 
         // Clamp value to chart range
         if (value < CHART_Y_MIN) value = CHART_Y_MIN;
         if (value > CHART_Y_MAX) value = CHART_Y_MAX;
 
         // Calculate X position based on actual minutes ago (plus elapsed time)
-        // Right edge = 0 minutes ago, left edge = 120 minutes ago
+        // now_x = 0 minutes ago, older points further left
         // pixels_per_minute = CHART_DOT_SPACING / 5
-        int total_minutes_ago = s_chart_minutes_ago[i] + elapsed_minutes;
+        int total_minutes_ago = account->chart_minutes_ago[i] + elapsed_minutes;
         int pixel_offset = (total_minutes_ago * CHART_DOT_SPACING) / 5;
-        int x = bounds.origin.x + bounds.size.w - margin - pixel_offset;
+        int x = now_x - pixel_offset;
 
         // Skip points that have scrolled off the left edge
         if (x < bounds.origin.x + margin) {
@@ -786,7 +1591,7 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
 
         // Set dot color based on platform
 #ifdef PBL_COLOR
-        graphics_context_set_fill_color(ctx, get_glucose_color(original_value));
+        graphics_context_set_fill_color(ctx, get_glucose_color(account->chart_values[i]));  // Unclamped value
 #else
         graphics_context_set_fill_color(ctx, fg_color);
 #endif
@@ -797,24 +1602,50 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
         graphics_fill_circle(ctx, GPoint(x, y), radius);
     }
 
-    // Draw meal markers
+    // Draw the predicted trajectory as hollow dots right of now
+    // (points drop off once they're no longer in the future, e.g. while data is stale)
+    graphics_context_set_stroke_width(ctx, 1);
+    for (int i = 0; i < account->prediction_count; i++) {
+        int total_minutes_ago = account->prediction_minutes_ago[i] + elapsed_minutes;
+        if (total_minutes_ago >= 0) {
+            continue;
+        }
+
+        int x = now_x - (total_minutes_ago * CHART_DOT_SPACING) / 5;
+        if (x > right_x) {
+            continue;
+        }
+
+        int value = account->prediction_values[i];
+        int y = chart_value_to_y(value, bounds, margin, chart_height);
+
+#ifdef PBL_COLOR
+        graphics_context_set_stroke_color(ctx, get_glucose_color(value));
+#else
+        graphics_context_set_stroke_color(ctx, fg_color);
+#endif
+        graphics_draw_circle(ctx, GPoint(x, y), CHART_DOT_RADIUS - 1);
+    }
+
+    // Draw meal markers (they're the main account's meals)
     // Use the same font as time ago layer: GOTHIC_24_BOLD
     GFont meal_font = fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD);
+    int meal_count = is_main_account_shown() ? s_meal_count : 0;
 
-    for (int i = 0; i < s_meal_count; i++) {
+    for (int i = 0; i < meal_count; i++) {
         int carbs = s_meal_carbs[i];
         int total_minutes_ago = s_meal_minutes_ago[i] + elapsed_minutes;
         bool is_future = total_minutes_ago < 0;
 
         // Calculate X position (same as CGM dots)
         int pixel_offset = (total_minutes_ago * CHART_DOT_SPACING) / 5;
-        int meal_x = bounds.origin.x + bounds.size.w - margin - pixel_offset;
+        int meal_x = now_x - pixel_offset;
         int text_y_offset = -6;
 
-        // For future meals (within next 20 minutes), position at right edge
-        // Shift left to leave room for right-pointing arrow
-        if (is_future) {
-            meal_x = bounds.origin.x + bounds.size.w - margin - 10;
+        // Future meals (within next 20 minutes) sit at their time in the prediction area,
+        // no further right than the right edge less room for the right-pointing arrow
+        if (is_future && meal_x > right_x - 10) {
+            meal_x = right_x - 10;
         }
 
         // Skip meals that have scrolled off the left edge
@@ -824,7 +1655,7 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
 
         // Format carbs as string
         char carbs_text[4];
-        snprintf(carbs_text, sizeof(carbs_text), "%d", carbs);
+        snprintf(carbs_text, sizeof(carbs_text), "%d", clamp_int(carbs, 0, 999));
 
         // Calculate text size
         GSize text_size = graphics_text_layout_get_content_size(
@@ -837,19 +1668,19 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
 
         // Find the CGM value at this time (or most recent if future)
         int reference_value = 140; // Default to middle value
-        if (s_chart_count > 0) {
+        if (account->chart_count > 0) {
             if (is_future || total_minutes_ago <= 0) {
                 // Use most recent CGM value for future meals
-                reference_value = s_chart_values[0];
+                reference_value = account->chart_values[0];
             } else {
                 // Find the closest CGM reading to this meal time
                 int min_time_diff = 999;
-                for (int j = 0; j < s_chart_count; j++) {
-                    int cgm_time = s_chart_minutes_ago[j] + elapsed_minutes;
+                for (int j = 0; j < account->chart_count; j++) {
+                    int cgm_time = account->chart_minutes_ago[j] + elapsed_minutes;
                     int time_diff = abs(cgm_time - total_minutes_ago);
                     if (time_diff < min_time_diff) {
                         min_time_diff = time_diff;
-                        reference_value = s_chart_values[j];
+                        reference_value = account->chart_values[j];
                     }
                 }
             }
@@ -936,6 +1767,7 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
                 .points = triangle_points
             };
             GPath *triangle = gpath_create(&triangle_info);
+            sample_heap("meal marker");
             gpath_draw_filled(ctx, triangle);
             gpath_destroy(triangle);
         }
@@ -955,6 +1787,7 @@ static void chart_layer_update_proc(Layer *layer, GContext *ctx) {
                 .points = arrow_points
             };
             GPath *arrow = gpath_create(&arrow_info);
+            sample_heap("meal marker");
             gpath_draw_filled(ctx, arrow);
             gpath_destroy(arrow);
         }
@@ -1003,33 +1836,38 @@ static void update_trend_icon(uint8_t trend) {
 /**
  * Update layout positions based on CGM text width
  * Dynamically positions trend arrow and delta based on actual rendered text width
- * Hides delta for LOW/HIGH values since there's no room
+ * The delta is hidden for LOW/HIGH values since there's no room
  */
-static void update_layout_for_cgm_text(const char *cgm_text) {
-    int cgmValueYPos = 24;
+static void update_layout_for_cgm_text(const char *cgm_text, bool show_delta) {
+    int value_y = s_value_row.origin.y;
 
-    // Check if this is a LOW or HIGH value - hide delta in these cases
-    bool hide_delta = (strcmp(cgm_text, "LOW") == 0 || strcmp(cgm_text, "HIGH") == 0);
-    layer_set_hidden(text_layer_get_layer(s_delta_layer), hide_delta);
+    layer_set_hidden(text_layer_get_layer(s_delta_layer), !show_delta);
 
     // Get the actual rendered width of the CGM text
     GSize text_size = graphics_text_layout_get_content_size(
         cgm_text,
         fonts_get_system_font(FONT_KEY_BITHAM_42_BOLD),
-        GRect(0, 0, 110, 48),
+        GRect(0, 0, 110, LAYOUT_VALUE_HEIGHT),
         GTextOverflowModeTrailingEllipsis,
         GTextAlignmentLeft
     );
 
-    // Position trend arrow just after the CGM text
-    // 4 is CGM layer x offset, add small gap after text
-    int trend_x = 4 + text_size.w + 3;
+    // Value, arrow and delta sit left-aligned in the row (centered on round screens)
+    int value_x = s_value_row.origin.x;
+#ifdef PBL_ROUND
+    int group_width = text_size.w + 3 + 32 + (show_delta ? LAYOUT_DELTA_WIDTH : 0);
+    value_x += (s_value_row.size.w - group_width) / 2;
+#endif
+    layer_set_frame(text_layer_get_layer(s_cgm_value_layer), GRect(value_x, value_y, 110, LAYOUT_VALUE_HEIGHT));
+
+    // Position trend arrow just after the CGM text, with a small gap
+    int trend_x = value_x + text_size.w + 3;
     int delta_x = trend_x + 32;
 
     layer_set_frame(bitmap_layer_get_layer(s_trend_layer),
-                    GRect(trend_x, cgmValueYPos + 13, 30, 30));
+                    GRect(trend_x, value_y + 13, 30, 30));
     layer_set_frame(text_layer_get_layer(s_delta_layer),
-                    GRect(delta_x, cgmValueYPos + 10, 38, 28));
+                    GRect(delta_x, value_y + 10, LAYOUT_DELTA_WIDTH, 28));
 }
 
 /**
@@ -1037,23 +1875,20 @@ static void update_layout_for_cgm_text(const char *cgm_text) {
  * Also handles showing "No Data" when CGM data is 60+ minutes old
  */
 static void update_time_ago_display() {
-    if (s_last_minutes_ago < 0) {
+    // Current minutes ago based on elapsed time since last data
+    int current_minutes_ago = account_minutes_ago(s_account);
+    if (current_minutes_ago < 0) {
         // No data received yet
         return;
     }
 
-    // Calculate current minutes ago based on elapsed time since last data
-    time_t now = time(NULL);
-    int elapsed_minutes = (int)((now - s_last_data_time) / 60);
-    int current_minutes_ago = s_last_minutes_ago + elapsed_minutes;
-
     // Check if data is stale (60+ minutes old)
     bool is_stale = current_minutes_ago >= 60;
 
-    // Show/hide CGM value, trend arrow, and delta based on staleness
+    // Show/hide CGM value, trend arrow, and delta based on staleness (LOW/HIGH has no delta)
     layer_set_hidden(text_layer_get_layer(s_cgm_value_layer), is_stale);
     layer_set_hidden(bitmap_layer_get_layer(s_trend_layer), is_stale);
-    layer_set_hidden(text_layer_get_layer(s_delta_layer), is_stale);
+    layer_set_hidden(text_layer_get_layer(s_delta_layer), is_stale || is_out_of_range(s_account->mgdl));
     layer_set_hidden(text_layer_get_layer(s_no_data_layer), !is_stale);
 
     // Update display
@@ -1094,35 +1929,152 @@ static void update_time() {
     char date_str[12];
     strftime(date_str, sizeof(date_str), "%a %e", tick_time);
 
-    // Combine with two spaces between
-    snprintf(s_time_date_buffer, sizeof(s_time_date_buffer), "%s  %s", time_ptr, date_str);
+    // Combine with two spaces between; when following several accounts, the account
+    // on screen is named in place of the date (round screens have no room for the date)
+    const char *label = s_account_count > 1 && s_account->label[0] ? s_account->label
+                                                                   : PBL_IF_ROUND_ELSE("", date_str);
+    snprintf(s_time_date_buffer, sizeof(s_time_date_buffer), "%s  %s", time_ptr, label);
     text_layer_set_text(s_time_date_layer, s_time_date_buffer);
 }
 
+/**
+ * Put an account's latest reading and chart on screen
+ */
+static void show_account(Account *account) {
+    s_account = account;
+
+    format_glucose(s_cgm_value_buffer, sizeof(s_cgm_value_buffer), account->mgdl);
+    text_layer_set_text(s_cgm_value_layer, s_cgm_value_buffer);
+    update_layout_for_cgm_text(s_cgm_value_buffer, !is_out_of_range(account->mgdl));
+    if (account->has_delta && account->mgdl > 0) {
+        format_delta(s_delta_buffer, sizeof(s_delta_buffer), account->delta_tenths);
+    } else {
+        s_delta_buffer[0] = '\0';
+    }
+    text_layer_set_text(s_delta_layer, s_delta_buffer);
+    update_trend_icon(account->trend);
+    if (account->minutes_ago < 0) {
+        text_layer_set_text(s_time_ago_layer, "---");
+    }
+    update_time_ago_display();
+    update_time();
+    layer_mark_dirty(s_chart_layer);
+}
+
+/**
+ * Change the number of followed accounts, forgetting the ones no longer followed
+ */
+static void set_account_count(int count) {
+    if (count == s_account_count) {
+        return;
+    }
+    for (int i = count; i < MAX_ACCOUNTS; i++) {
+        account_reset(&s_accounts[i]);
+    }
+    s_account_count = count;
+    show_account(s_account - s_accounts < count ? s_account : &s_accounts[0]);
+}
+
+/**
+ * Bring back the default view of the main account
+ */
+static void view_revert_callback(void *data) {
+    s_view_revert_timer = NULL;
+    s_shown_view = s_default_view;
+    show_account(&s_accounts[0]);
+}
+
+/**
+ * The main account's data has reached the alarm age: vibrate and bring it on screen
+ */
+static void stale_alarm_callback(void *data) {
+    s_stale_alarm_timer = NULL;
+
+    // Long, even buzzes, unlike the glucose alerts' short pulses
+    static const uint32_t stale_pattern[] = { 600, 300, 600, 300, 600 };
+    vibes_enqueue_custom_pattern((VibePattern) {
+        .durations = stale_pattern,
+        .num_segments = ARRAY_LENGTH(stale_pattern)
+    });
+    APP_LOG(APP_LOG_LEVEL_INFO, "Stale data alarm vibration triggered");
+
+    s_shown_view = s_default_view;
+    show_account(&s_accounts[0]);
+}
+
+/**
+ * Arm the stale-data alarm for a reading of the main account
+ * Messages repeating the reading it's armed for leave it alone (unless forced, for a
+ * settings change), so polls that bring nothing new neither delay nor repeat it.
+ * A reading that's already past the alarm age fires it straight away.
+ */
+static void stale_alarm_arm(time_t reading_time, bool force) {
+    if (!force && abs((int)(reading_time - s_stale_alarm_reading_time)) < STALE_ALARM_SAME_READING_S) {
+        return;
+    }
+    s_stale_alarm_reading_time = reading_time;
+
+    if (s_stale_alarm_timer) {
+        app_timer_cancel(s_stale_alarm_timer);
+        s_stale_alarm_timer = NULL;
+    }
+    if (s_stale_alarm_minutes == 0 || reading_time == 0) {
+        return;
+    }
+
+    int32_t delay = (int32_t)(reading_time + s_stale_alarm_minutes * 60 - time(NULL));
+    s_stale_alarm_timer = app_timer_register(delay > 0 ? (uint32_t)delay * 1000 : 0, stale_alarm_callback, NULL);
+}
+
+/**
+ * Tap (wrist flick) handler - show the next view: the main account's chart, long-range
+ * chart and statistics, then each other followed account's chart
+ * Views are drawn from data already on the watch; the default comes back after VIEW_REVERT_MS.
+ */
+static void accel_tap_handler(AccelAxisType axis, int32_t direction) {
+    if (is_main_account_shown() && s_shown_view != VIEW_STATS) {
+        s_shown_view = s_shown_view == VIEW_CHART ? VIEW_LONG : VIEW_STATS;
+        show_account(s_account);
+    } else {
+        s_shown_view = VIEW_CHART;
+        show_account(&s_accounts[(s_account - s_accounts + 1) % s_account_count]);
+    }
+
+    if (s_view_revert_timer) {
+        app_timer_cancel(s_view_revert_timer);
+        s_view_revert_timer = NULL;
+    }
+    if (!is_main_account_shown() || s_shown_view != s_default_view) {
+        s_view_revert_timer = app_timer_register(VIEW_REVERT_MS, view_revert_callback, NULL);
+    }
+}
+
 /**
  * Tick handler - called every minute
  */
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
     update_time();
     update_time_ago_display();
+    stats_expire(time(NULL));
 
     // Redraw chart to shift dots based on elapsed time
     if (s_chart_layer) {
         layer_mark_dirty(s_chart_layer);
     }
 
-    // Only request data from phone if CGM reading is 4+ minutes old
+    // Only request data from phone if a CGM reading is missing or 4+ minutes old
     // (Dexcom only updates every 5 minutes, so no point asking more frequently)
-    if (s_last_data_time > 0 && s_last_minutes_ago >= 0) {
-        time_t now = time(NULL);
-        int elapsed_minutes = (int)((now - s_last_data_time) / 60);
-        int current_cgm_age = s_last_minutes_ago + elapsed_minutes;
-
-        if (current_cgm_age < 4) {
-            // Data is still fresh, no need to request update
-            return;
+    bool is_fresh = true;
+    for (int i = 0; i < s_account_count; i++) {
+        int current_cgm_age = account_minutes_ago(&s_accounts[i]);
+        if (current_cgm_age < 0 || current_cgm_age >= 4) {
+            is_fresh = false;
         }
     }
+    if (is_fresh) {
+        // Data is still fresh, no need to request update
+        return;
+    }
 
     // Request data update from phone
     DictionaryIterator *iter;
@@ -1134,6 +2086,58 @@ static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
     }
 }
 
+/**
+ * Get a tuple's string value, or NULL if the tuple isn't a NUL-terminated string
+ */
+static const char *tuple_get_cstring(const Tuple *tuple) {
+    if (!tuple || tuple->type != TUPLE_CSTRING || tuple->length == 0 ||
+        tuple->value->cstring[tuple->length - 1] != '\0') {
+        return NULL;
+    }
+    return tuple->value->cstring;
+}
+
+/**
+ * Get a tuple's integer value whatever its width (PebbleKit JS sends numbers as int32)
+ * Returns the fallback for tuples that aren't integers
+ */
+static int32_t tuple_get_int(const Tuple *tuple, int32_t fallback) {
+    if (!tuple || (tuple->type != TUPLE_INT && tuple->type != TUPLE_UINT)) {
+        return fallback;
+    }
+
+    bool is_signed = tuple->type == TUPLE_INT;
+    switch (tuple->length) {
+        case 1: return is_signed ? tuple->value->int8 : tuple->value->uint8;
+        case 2: return is_signed ? tuple->value->int16 : tuple->value->uint16;
+        case 4: return is_signed ? tuple->value->int32 : (int32_t)tuple->value->uint32;
+        default: return fallback;
+    }
+}
+
+/**
+ * Ack an alert id and remember it
+ * Returns false for an id already handled (the phone resends until it gets the ack)
+ */
+static bool accept_alert(int32_t alert_id) {
+    DictionaryIterator *iter;
+    if (app_message_outbox_begin(&iter) == APP_MSG_OK && iter) {
+        dict_write_int32(iter, KEY_ALERT_ID, alert_id);
+        app_message_outbox_send();
+    } else {
+        APP_LOG(APP_LOG_LEVEL_WARNING, "Couldn't ack alert %d, the phone will resend it", (int)alert_id);
+    }
+
+    for (int i = 0; i < ALERT_RECENT_IDS; i++) {
+        if (s_recent_alert_ids[i] == alert_id) {
+            return false;
+        }
+    }
+    s_recent_alert_ids[s_recent_alert_next] = alert_id;
+    s_recent_alert_next = (s_recent_alert_next + 1) % ALERT_RECENT_IDS;
+    return true;
+}
+
 /**
  * AppMessage received callback
  */
@@ -1141,83 +2145,172 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     // Clear outbox failure flag on successful communication
     s_has_outbox_failure = false;
 
-    // Check for sync error flag from iOS app (API failure)
-    Tuple *sync_error_tuple = dict_find(iterator, KEY_SYNC_ERROR);
-    if (sync_error_tuple) {
-        s_has_sync_error = sync_error_tuple->value->uint8 != 0;
-    } else {
-        // If not present, assume success (for backwards compatibility)
-        s_has_sync_error = false;
+    // Find the account this message is for (untagged messages are for the main account)
+    Tuple *account_count_tuple = dict_find(iterator, KEY_ACCOUNT_COUNT);
+    if (account_count_tuple) {
+        set_account_count(clamp_int(tuple_get_int(account_count_tuple, 1), 1, MAX_ACCOUNTS));
     }
+    int32_t account_index = tuple_get_int(dict_find(iterator, KEY_ACCOUNT), 0);
+    if (account_index < 0 || account_index >= s_account_count) {
+        APP_LOG(APP_LOG_LEVEL_ERROR, "Message for unknown account %d", (int)account_index);
+        return;
+    }
+    Account *account = &s_accounts[account_index];
+    bool is_main_account = account_index == 0;
 
-    // Show sync spinner briefly to indicate data reception
-    start_sync_spinner();
-
-    // Hide loading state on first data received
-    if (s_is_loading) {
-        hide_loading_show_data();
+    const char *label = tuple_get_cstring(dict_find(iterator, KEY_ACCOUNT_LABEL));
+    if (label) {
+        snprintf(account->label, sizeof(account->label), "%s", label);
     }
 
-    // Read CGM value
+    // Readings carry a history and errors clear the value; a settings change alone
+    // (e.g. units) has neither
     Tuple *cgm_value_tuple = dict_find(iterator, KEY_CGM_VALUE);
-    if (cgm_value_tuple) {
-        snprintf(s_cgm_value_buffer, sizeof(s_cgm_value_buffer), "%s", cgm_value_tuple->value->cstring);
-        text_layer_set_text(s_cgm_value_layer, s_cgm_value_buffer);
-        update_layout_for_cgm_text(s_cgm_value_buffer);
-    }
+    Tuple *history_tuple = dict_find(iterator, KEY_CGM_HISTORY);
+    if (cgm_value_tuple || history_tuple) {
+        // Check for sync error flag from iOS app (API failure)
+        Tuple *sync_error_tuple = dict_find(iterator, KEY_SYNC_ERROR);
+        if (sync_error_tuple) {
+            account->has_sync_error = tuple_get_int(sync_error_tuple, 0) != 0;
+        } else {
+            // If not present, assume success (for backwards compatibility)
+            account->has_sync_error = false;
+        }
 
-    // Read delta
-    Tuple *delta_tuple = dict_find(iterator, KEY_CGM_DELTA);
-    if (delta_tuple) {
-        snprintf(s_delta_buffer, sizeof(s_delta_buffer), "%s", delta_tuple->value->cstring);
-        text_layer_set_text(s_delta_layer, s_delta_buffer);
+        // Show sync spinner briefly to indicate data reception
+        start_sync_spinner();
+
+        // Hide loading state on first data received
+        if (s_is_loading) {
+            hide_loading_show_data();
+        }
+
+        // Read CGM value (mg/dL, formatted for display when the account is shown)
+        if (cgm_value_tuple) {
+            account->mgdl = (int16_t)clamp_int(tuple_get_int(cgm_value_tuple, 0), 0, MAX_THRESHOLD);
+        }
     }
 
     // Read trend
     Tuple *trend_tuple = dict_find(iterator, KEY_CGM_TREND);
     if (trend_tuple) {
-        update_trend_icon(trend_tuple->value->uint8);
+        account->trend = (uint8_t)tuple_get_int(trend_tuple, TREND_NONE);
     }
 
     // Read time ago
     Tuple *time_ago_tuple = dict_find(iterator, KEY_CGM_TIME_AGO);
     if (time_ago_tuple) {
-        s_last_minutes_ago = time_ago_tuple->value->int32;
-        s_last_data_time = time(NULL);
-        update_time_ago_display();
+        account->minutes_ago = clamp_int(tuple_get_int(time_ago_tuple, 0), 0, MAX_MINUTES_AGO);
+        account->data_time = time(NULL);
     }
 
-    // Read chart history
-    Tuple *history_tuple = dict_find(iterator, KEY_CGM_HISTORY);
+    // Read chart history; its first point is the latest reading
     if (history_tuple) {
-        parse_chart_history(history_tuple->value->cstring);
+        parse_chart_history(account, tuple_get_cstring(history_tuple));
+        account->mgdl = account->chart_count > 0 ? clamp_int(account->chart_values[0], 0, MAX_THRESHOLD) : 0;
+        update_delta(account);
+        if (is_main_account) {
+            stats_add_history(account, time(NULL));
+            if (account->minutes_ago >= 0) {
+                stale_alarm_arm(time(NULL) - account_minutes_ago(account) * 60, false);
+            }
+        }
+    }
+
+    // Derive the arrow from the delta when the source has no trend for this reading
+    if (trend_tuple && account->trend == TREND_NONE) {
+        account->trend = trend_from_delta(account);
+    }
+
+    // Read display units (before the account is drawn)
+    Tuple *unit_tuple = dict_find(iterator, KEY_UNIT);
+    if (unit_tuple) {
+        bool new_mmol = tuple_get_int(unit_tuple, 0) != 0;
+        if (new_mmol != s_mmol) {
+            s_mmol = new_mmol;
+            if (account != s_account) {
+                show_account(s_account);
+            }
+        }
+    }
+
+    // Read predicted trajectory
+    Tuple *prediction_tuple = dict_find(iterator, KEY_PREDICTION);
+    if (prediction_tuple) {
+        parse_prediction_data(account, tuple_get_cstring(prediction_tuple));
+    }
+
+    // An alert brings its account on screen; otherwise only the account on screen is redrawn
+    // (alerts with an id are acked, and one handled before is ignored)
+    Tuple *alert_tuple = dict_find(iterator, KEY_CGM_ALERT);
+    Tuple *alert_id_tuple = dict_find(iterator, KEY_ALERT_ID);
+    if (alert_tuple && alert_id_tuple && !accept_alert(tuple_get_int(alert_id_tuple, 0))) {
+        alert_tuple = NULL;
+    }
+    int32_t alert_type = tuple_get_int(alert_tuple, ALERT_NONE);
+    if (account == s_account || alert_type != ALERT_NONE) {
+        show_account(account);
+    }
+
+    // Read percentile bands (a single byte clears them)
+    Tuple *bands_tuple = dict_find(iterator, KEY_BANDS);
+    if (bands_tuple) {
+        s_has_bands = bands_tuple->type == TUPLE_BYTE_ARRAY && bands_tuple->length == sizeof(s_bands);
+        if (s_has_bands) {
+            memcpy(s_bands, bands_tuple->value->data, sizeof(s_bands));
+        }
         layer_mark_dirty(s_chart_layer);
     }
 
     // Read meal data
     Tuple *meal_data_tuple = dict_find(iterator, KEY_MEAL_DATA);
     if (meal_data_tuple) {
-        parse_meal_data(meal_data_tuple->value->cstring);
+        parse_meal_data(tuple_get_cstring(meal_data_tuple));
         layer_mark_dirty(s_chart_layer);
     }
 
     // Read threshold settings
+    int old_low_threshold = s_low_threshold;
+    int old_high_threshold = s_high_threshold;
+
     Tuple *low_threshold_tuple = dict_find(iterator, KEY_LOW_THRESHOLD);
     if (low_threshold_tuple) {
-        s_low_threshold = low_threshold_tuple->value->int32;
+        s_low_threshold = clamp_int(tuple_get_int(low_threshold_tuple, s_low_threshold), 0, MAX_THRESHOLD);
         layer_mark_dirty(s_chart_layer);
     }
 
     Tuple *high_threshold_tuple = dict_find(iterator, KEY_HIGH_THRESHOLD);
     if (high_threshold_tuple) {
-        s_high_threshold = high_threshold_tuple->value->int32;
+        s_high_threshold = clamp_int(tuple_get_int(high_threshold_tuple, s_high_threshold), 0, MAX_THRESHOLD);
+        layer_mark_dirty(s_chart_layer);
+    }
+
+    if (s_low_threshold != old_low_threshold || s_high_threshold != old_high_threshold) {
+        stats_recount_ranges();
+    }
+
+    // Read chart area view
+    Tuple *view_tuple = dict_find(iterator, KEY_DEFAULT_VIEW);
+    if (view_tuple) {
+        s_default_view = clamp_int(tuple_get_int(view_tuple, VIEW_CHART), VIEW_CHART, VIEW_LONG);
+        if (!s_view_revert_timer) {
+            s_shown_view = s_default_view;
+        }
         layer_mark_dirty(s_chart_layer);
     }
 
+    // Read stale-data alarm age
+    Tuple *stale_alarm_tuple = dict_find(iterator, KEY_STALE_ALARM);
+    if (stale_alarm_tuple) {
+        int minutes = clamp_int(tuple_get_int(stale_alarm_tuple, 0), 0, STALE_ALARM_MAX_MINUTES);
+        if (minutes != s_stale_alarm_minutes) {
+            s_stale_alarm_minutes = minutes;
+            stale_alarm_arm(s_stale_alarm_reading_time, true);
+        }
+    }
+
     // Handle alert vibration
-    Tuple *alert_tuple = dict_find(iterator, KEY_CGM_ALERT);
     if (alert_tuple) {
-        uint8_t alert_type = alert_tuple->value->uint8;
         if (alert_type == ALERT_LOW_SOON) {
             // Low soon alert: accelerating pattern
             static const uint32_t low_soon_pattern[] = { 70, 300, 70, 200, 70, 120, 70, 80, 70 };
@@ -1240,7 +2333,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     // Read reversed setting
     Tuple *reversed_tuple = dict_find(iterator, KEY_REVERSED);
     if (reversed_tuple) {
-        bool new_reversed = reversed_tuple->value->uint8 != 0;
+        bool new_reversed = tuple_get_int(reversed_tuple, 0) != 0;
         if (new_reversed != s_reversed) {
             s_reversed = new_reversed;
             apply_colors();
@@ -1249,7 +2342,7 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
 
     // Check for setup needed message
     Tuple *needs_setup_tuple = dict_find(iterator, KEY_NEEDS_SETUP);
-    if (needs_setup_tuple && needs_setup_tuple->value->uint8) {
+    if (needs_setup_tuple && tuple_get_int(needs_setup_tuple, 0)) {
         // Hide CGM data, show setup message
         hide_data_layers();
         layer_set_hidden(text_layer_get_layer(s_setup_layer), false);
@@ -1260,6 +2353,8 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
         // Update CGM value/trend/delta visibility based on staleness
         update_time_ago_display();
     }
+
+    sample_heap("message");
 }
 
 /**
@@ -1275,6 +2370,11 @@ static void inbox_dropped_callback(AppMessageResult reason, void *context) {
 static void outbox_failed_callback(DictionaryIterator *iterator, AppMessageResult reason, void *context) {
     APP_LOG(APP_LOG_LEVEL_ERROR, "Outbox send failed: %d", reason);
 
+    // A lost alert ack is covered by the phone resending the alert
+    if (dict_find(iterator, KEY_ALERT_ID)) {
+        return;
+    }
+
     // Only retry once to avoid infinite loops
     if (!s_is_retry) {
         APP_LOG(APP_LOG_LEVEL_INFO, "Retrying outbox send...");
@@ -1333,29 +2433,35 @@ static void main_window_load(Window *window) {
     // Layout (top to bottom):
     // - Time + Date (single row, medium font) - height ~28
     // - CGM value (large) + trend arrow + delta - height ~50
-    // - Time ago - height ~20
     // - Chart - remaining space
-
-    // Time and date layer - single row at top, left-aligned
+    // - Battery, sync/alert icon and time ago - height ~24
+    int top = bounds.origin.y + LAYOUT_INSET_TOP;
+    int status_y = bounds.origin.y + bounds.size.h - LAYOUT_INSET_BOTTOM - LAYOUT_STATUS_HEIGHT;
+    int status_left = LAYOUT_STATUS_INSET_X;
+    int status_width = bounds.size.w - LAYOUT_STATUS_INSET_X * 2;
+    GRect chart = GRect(LAYOUT_CHART_INSET_X, top + LAYOUT_CHART_Y, bounds.size.w - LAYOUT_CHART_INSET_X * 2,
+                        status_y + 6 - (top + LAYOUT_CHART_Y));
+    s_value_row = GRect(PBL_IF_ROUND_ELSE(0, 4), top + LAYOUT_VALUE_Y, bounds.size.w - PBL_IF_ROUND_ELSE(0, 4),
+                        LAYOUT_VALUE_HEIGHT);
+
+    // Time and date layer - single row at top (left-aligned, centered on round screens)
     s_time_date_layer = create_text_layer(
-        GRect(6, -4, bounds.size.w - 6, 34),
-        fonts_get_system_font(FONT_KEY_GOTHIC_28_BOLD),
-        GTextAlignmentLeft
+        GRect(PBL_IF_ROUND_ELSE(0, 6), top - 4, bounds.size.w - PBL_IF_ROUND_ELSE(0, 6), 34),
+        fonts_get_system_font(PBL_IF_ROUND_ELSE(FONT_KEY_GOTHIC_24_BOLD, FONT_KEY_GOTHIC_28_BOLD)),
+        PBL_IF_ROUND_ELSE(GTextAlignmentCenter, GTextAlignmentLeft)
     );
     layer_add_child(window_layer, text_layer_get_layer(s_time_date_layer));
 
-    int cgmValueYPos = 24;
-
-    // CGM value layer - centered vertically at y=26, font height ~34px
+    // CGM value layer - placed with the trend arrow and delta by update_layout_for_cgm_text()
     s_cgm_value_layer = create_text_layer(
-        GRect(4, cgmValueYPos, 110, 48),
+        GRect(s_value_row.origin.x, s_value_row.origin.y, 110, LAYOUT_VALUE_HEIGHT),
         fonts_get_system_font(FONT_KEY_BITHAM_42_BOLD),
         GTextAlignmentLeft
     );
     text_layer_set_text(s_cgm_value_layer, "");
     layer_add_child(window_layer, text_layer_get_layer(s_cgm_value_layer));
 
-    s_trend_layer = bitmap_layer_create(GRect(78, cgmValueYPos + 13, 30, 30));
+    s_trend_layer = bitmap_layer_create(GRect(s_value_row.origin.x + 74, s_value_row.origin.y + 13, 30, 30));
     bitmap_layer_set_compositing_mode(s_trend_layer, GCompOpOr);
     bitmap_layer_set_alignment(s_trend_layer, GAlignCenter);
     const uint32_t *icons = s_reversed ? TREND_ICONS_BLACK : TREND_ICONS_WHITE;
@@ -1364,7 +2470,7 @@ static void main_window_load(Window *window) {
     layer_add_child(window_layer, bitmap_layer_get_layer(s_trend_layer));
 
     s_delta_layer = create_text_layer(
-        GRect(110, cgmValueYPos + 12, 38, 28),
+        GRect(s_value_row.origin.x + 106, s_value_row.origin.y + 12, LAYOUT_DELTA_WIDTH, 28),
         fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD),
         GTextAlignmentLeft
     );
@@ -1373,7 +2479,7 @@ static void main_window_load(Window *window) {
 
     // "No Data" layer - shown when CGM data is 60+ minutes old, centered in CGM value area
     s_no_data_layer = create_text_layer(
-        GRect(0, cgmValueYPos + 10, bounds.size.w, 28),
+        GRect(0, s_value_row.origin.y + 10, bounds.size.w, 28),
         fonts_get_system_font(FONT_KEY_GOTHIC_28_BOLD),
         GTextAlignmentCenter
     );
@@ -1381,14 +2487,14 @@ static void main_window_load(Window *window) {
     layer_set_hidden(text_layer_get_layer(s_no_data_layer), true);
     layer_add_child(window_layer, text_layer_get_layer(s_no_data_layer));
 
-    // Chart layer - below CGM value row
-    s_chart_layer = layer_create(GRect(0, 70, bounds.size.w, 74));
+    // Chart layer - between the CGM value row and the status row
+    s_chart_layer = layer_create(chart);
     layer_set_update_proc(s_chart_layer, chart_layer_update_proc);
     layer_add_child(window_layer, s_chart_layer);
 
     // Time ago layer - bottom of screen, right-aligned
     s_time_ago_layer = create_text_layer(
-        GRect(0, 138, bounds.size.w - 6, 28),
+        GRect(status_left, status_y, status_width - 6, 28),
         fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD),
         GTextAlignmentRight
     );
@@ -1396,24 +2502,24 @@ static void main_window_load(Window *window) {
     layer_add_child(window_layer, text_layer_get_layer(s_time_ago_layer));
 
     // Battery layer - bottom left corner
-    s_battery_layer = layer_create(GRect(4, 145, 30, 22));
+    s_battery_layer = layer_create(GRect(status_left + 4, status_y + 7, 30, 22));
     layer_set_update_proc(s_battery_layer, battery_layer_update_proc);
     layer_add_child(window_layer, s_battery_layer);
 
     // Sync spinner layer - to the right of battery icon
-    s_sync_layer = layer_create(GRect(34, 148, 16, 16));
+    s_sync_layer = layer_create(GRect(status_left + 34, status_y + 10, 16, 16));
     layer_set_update_proc(s_sync_layer, sync_layer_update_proc);
     layer_add_child(window_layer, s_sync_layer);
 
     // Alert triangle layer - same position as sync layer (mutually exclusive visibility)
-    s_alert_layer = layer_create(GRect(33, 146, 20, 20));
+    s_alert_layer = layer_create(GRect(status_left + 33, status_y + 8, 20, 20));
     layer_set_update_proc(s_alert_layer, alert_layer_update_proc);
     layer_set_hidden(s_alert_layer, true);  // Hidden by default
     layer_add_child(window_layer, s_alert_layer);
 
     // Setup message layer - centered, covers chart area, hidden by default
     s_setup_layer = create_text_layer(
-        GRect(6, 50, bounds.size.w - 12, 74),
+        GRect(chart.origin.x + 6, top + 50, chart.size.w - 12, 74),
         fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD),
         GTextAlignmentCenter
     );
@@ -1422,7 +2528,8 @@ static void main_window_load(Window *window) {
     layer_add_child(window_layer, text_layer_get_layer(s_setup_layer));
 
     // Loading layer - centered in the data area, shows jumping dots
-    s_loading_layer = layer_create(GRect(0, 24, bounds.size.w, 120));
+    s_loading_layer = layer_create(GRect(0, s_value_row.origin.y, bounds.size.w,
+                                         chart.origin.y + chart.size.h - s_value_row.origin.y));
     layer_set_update_proc(s_loading_layer, loading_layer_update_proc);
     layer_add_child(window_layer, s_loading_layer);
 
@@ -1433,6 +2540,8 @@ static void main_window_load(Window *window) {
 
     // Initialize time display
     update_time();
+
+    sample_heap("load");
 }
 
 /**
@@ -1458,6 +2567,14 @@ static void main_window_unload(Window *window) {
         app_timer_cancel(s_sync_stop_timer);
         s_sync_stop_timer = NULL;
     }
+    if (s_view_revert_timer) {
+        app_timer_cancel(s_view_revert_timer);
+        s_view_revert_timer = NULL;
+    }
+    if (s_stale_alarm_timer) {
+        app_timer_cancel(s_stale_alarm_timer);
+        s_stale_alarm_timer = NULL;
+    }
 
     text_layer_destroy(s_time_date_layer);
     text_layer_destroy(s_cgm_value_layer);
@@ -1481,6 +2598,16 @@ static void main_window_unload(Window *window) {
  * Initialize app
  */
 static void init() {
+    // No readings for any account until the phone sends them
+    for (int i = 0; i < MAX_ACCOUNTS; i++) {
+        account_reset(&s_accounts[i]);
+    }
+    s_account_count = 1;
+    s_account = &s_accounts[0];
+
+    // Restore the 24-hour statistics window
+    stats_load();
+
     // Create main window
     s_main_window = window_create();
     window_set_window_handlers(s_main_window, (WindowHandlers) {
@@ -1489,6 +2616,17 @@ static void init() {
     });
     window_stack_push(s_main_window, true);
 
+    // Keep watching the age of the last reading from before a restart, in case the phone
+    // doesn't come back (data that was already past the alarm age isn't alarmed again)
+    StaleAlarmState stale_alarm;
+    if (persist_read_data(PERSIST_KEY_STALE_ALARM, &stale_alarm, sizeof(stale_alarm)) == (int)sizeof(stale_alarm)) {
+        s_stale_alarm_minutes = clamp_int(stale_alarm.minutes, 0, STALE_ALARM_MAX_MINUTES);
+        s_stale_alarm_reading_time = stale_alarm.reading_time;
+        if (stale_alarm.reading_time + s_stale_alarm_minutes * 60 > time(NULL)) {
+            stale_alarm_arm(stale_alarm.reading_time, true);
+        }
+    }
+
     // Register tick handler
     tick_timer_service_subscribe(MINUTE_UNIT, tick_handler);
 
@@ -1496,6 +2634,9 @@ static void init() {
     battery_state_service_subscribe(battery_handler);
     battery_handler(battery_state_service_peek());
 
+    // Taps cycle chart, 12-hour chart and stats, then the next followed account
+    accel_tap_service_subscribe(accel_tap_handler);
+
     // Register AppMessage callbacks
     app_message_register_inbox_received(inbox_received_callback);
     app_message_register_inbox_dropped(inbox_dropped_callback);
@@ -1503,8 +2644,8 @@ static void init() {
     app_message_register_outbox_sent(outbox_sent_callback);
 
     // Open AppMessage with appropriate buffer sizes
-    // Inbox needs to hold chart history (24 values * ~8 chars each = ~192) plus other fields
-    app_message_open(512, 64);
+    // Inbox holds the largest data message (690 bytes with 32 chart points, 618 with 24)
+    app_message_open(INBOX_SIZE, 64);
 }
 
 /**
@@ -1513,7 +2654,16 @@ static void init() {
 static void deinit() {
     tick_timer_service_unsubscribe();
     battery_state_service_unsubscribe();
+    accel_tap_service_unsubscribe();
     window_destroy(s_main_window);
+    stats_save();
+    persist_write_data(PERSIST_KEY_STALE_ALARM, &(StaleAlarmState) {
+        .minutes = s_stale_alarm_minutes,
+        .reading_time = (int32_t)s_stale_alarm_reading_time
+    }, sizeof(StaleAlarmState));
+
+    APP_LOG(APP_LOG_LEVEL_INFO, "Heap high-water: %d bytes (%s)",
+            (int)s_heap_high_water, s_heap_high_water_at);
 }
 
 /**
@@ -1523,4 +2673,5 @@ int main(void) {
     init();
     app_event_loop();
     deinit();
+    return 0;
 }
@@ -0,0 +1,249 @@
+/**
+ * T1000 CGM Watchface - Alert engine
+ *
+ * Alerts are described as rules (condition, duration, repeat, hysteresis) and
+ * evaluated incrementally, one reading at a time. Timing is based on reading
+ * timestamps rather than the wall clock, so a day of readings can be replayed
+ * deterministically with replay().
+ */
+
+var Prediction = require("./prediction");
+
+// Alert types sent to the watch (must match main.c)
+var ALERT_NONE = 0;
+var ALERT_LOW_SOON = 1;
+var ALERT_HIGH = 2;
+
+/**
+ * Build the alert rules from the user's settings
+ * Rules are evaluated in order and the first one that fires wins.
+ *
+ * Rule fields:
+ *   condition       { type: "threshold" | "predicted", above | below, minutes (predicted only) }
+ *   durationMinutes condition must hold this long before the first alert
+ *   repeatMinutes   minimum time between alerts (not reset when the condition clears)
+ *   hysteresis      mg/dL past the threshold needed to clear an active condition
+ */
+function rulesFromSettings(settings) {
+	return [
+		{
+			id: "lowSoon",
+			alert: ALERT_LOW_SOON,
+			enabled: !!settings.vibeLowSoonEnabled,
+			condition: { type: "predicted", below: settings.vibeLowSoonThreshold, minutes: 20 },
+			durationMinutes: 0,
+			repeatMinutes: settings.vibeLowSoonRepeatMinutes,
+			hysteresis: 0
+		},
+		{
+			id: "high",
+			alert: ALERT_HIGH,
+			enabled: !!settings.vibeEnabled,
+			condition: { type: "threshold", above: settings.vibeHighThreshold },
+			durationMinutes: settings.vibeDelayMinutes,
+			repeatMinutes: settings.vibeRepeatMinutes,
+			// Hovering around the threshold shouldn't restart the delay
+			hysteresis: 10
+		}
+	];
+}
+
+/**
+ * Create an engine for a set of rules, optionally restoring serialized state
+ */
+function AlertEngine(rules, state) {
+	this.rules = rules;
+	this.ruleState = {};
+	this.lastEventTime = null;
+	this.dirty = false;
+
+	if (state) {
+		this.lastEventTime = state.lastEventTime || null;
+		for (var id in state.rules) {
+			this.ruleState[id] = state.rules[id];
+		}
+	}
+}
+
+/**
+ * Replace the rules (e.g. after a settings change), keeping per-rule state
+ */
+AlertEngine.prototype.setRules = function (rules) {
+	this.rules = rules;
+};
+
+/**
+ * Get (creating if needed) the state for a rule
+ */
+AlertEngine.prototype.getRuleState = function (id) {
+	if (!this.ruleState[id]) {
+		this.ruleState[id] = { active: false, activeSince: null, lastFired: null, previousFired: null };
+	}
+	return this.ruleState[id];
+};
+
+/**
+ * Get the value a rule's condition tests for a reading event
+ * Returns null if it can't be evaluated (e.g. no prediction yet)
+ */
+function getConditionValue(rule, event) {
+	var condition = rule.condition;
+	var value = event.value;
+
+	if (condition.type === "predicted") {
+		value = null;
+		var predictions = event.predictions || [];
+		for (var i = 0; i < predictions.length; i++) {
+			if (predictions[i].minutes === condition.minutes) {
+				value = predictions[i].value;
+			}
+		}
+	}
+
+	return value;
+}
+
+/**
+ * Check a value against a condition's threshold, moved back by `slack` mg/dL
+ */
+function isPastThreshold(condition, value, slack) {
+	if (condition.above !== undefined) {
+		return value >= condition.above - slack;
+	}
+	if (condition.below !== undefined) {
+		return value < condition.below + slack;
+	}
+	return false;
+}
+
+/**
+ * Evaluate all rules for a new reading event { time, value, predictions }
+ * Events at or before the last evaluated reading are ignored.
+ * Returns the alert type to send (ALERT_NONE if nothing fired).
+ */
+AlertEngine.prototype.evaluate = function (event) {
+	if (this.lastEventTime !== null && event.time <= this.lastEventTime) {
+		return ALERT_NONE;
+	}
+	this.lastEventTime = event.time;
+
+	var result = ALERT_NONE;
+
+	for (var i = 0; i < this.rules.length; i++) {
+		var rule = this.rules[i];
+		if (!rule.enabled) {
+			continue;
+		}
+
+		var state = this.getRuleState(rule.id);
+		var value = getConditionValue(rule, event);
+		if (value === null) {
+			continue;
+		}
+
+		// Once active, the rule only clears once the value is past the threshold by the
+		// hysteresis, but it only fires while the threshold itself is crossed
+		var met = isPastThreshold(rule.condition, value, 0);
+		var held = met || (state.active && isPastThreshold(rule.condition, value, rule.hysteresis || 0));
+		if (!held) {
+			// Restart the duration timer, but keep lastFired so the repeat interval still applies
+			if (state.active) {
+				state.active = false;
+				state.activeSince = null;
+				this.dirty = true;
+			}
+			continue;
+		}
+
+		if (!state.active) {
+			state.active = true;
+			state.activeSince = event.time;
+			this.dirty = true;
+		}
+
+		var heldMinutes = (event.time - state.activeSince) / 60000;
+		var sinceFiredMinutes = state.lastFired === null ? Infinity : (event.time - state.lastFired) / 60000;
+
+		// Only one alert per reading; a lower-priority rule fires on a later reading instead
+		if (met && result === ALERT_NONE && heldMinutes >= rule.durationMinutes && sinceFiredMinutes >= rule.repeatMinutes) {
+			state.previousFired = state.lastFired;
+			state.lastFired = event.time;
+			this.dirty = true;
+			result = rule.alert;
+		}
+	}
+
+	return result;
+};
+
+/**
+ * Take back an alert that fired for the reading at `time` but never reached the watch,
+ * so the repeat interval doesn't hold back the next one
+ */
+AlertEngine.prototype.retract = function (alert, time) {
+	for (var i = 0; i < this.rules.length; i++) {
+		var state = this.ruleState[this.rules[i].id];
+		if (this.rules[i].alert === alert && state && state.lastFired === time) {
+			state.lastFired = state.previousFired === undefined ? null : state.previousFired;
+			this.dirty = true;
+		}
+	}
+};
+
+/**
+ * Whether rule state changed since the last call to markSaved()
+ * (state is persisted in batches, only when something actually changed)
+ */
+AlertEngine.prototype.needsSave = function () {
+	return this.dirty;
+};
+
+AlertEngine.prototype.markSaved = function () {
+	this.dirty = false;
+};
+
+/**
+ * Serializable engine state
+ */
+AlertEngine.prototype.serialize = function () {
+	return {
+		lastEventTime: this.lastEventTime,
+		rules: this.ruleState
+	};
+};
+
+/**
+ * Replay readings (any order, { time, value } in mg/dL) through a fresh engine
+ * Returns the alerts that would have fired: [{ time, value, alert }]
+ */
+function replay(settings, readings) {
+	var engine = new AlertEngine(rulesFromSettings(settings));
+	var predictor = new Prediction.Predictor();
+	var sorted = readings.slice().sort(function (a, b) {
+		return a.time - b.time;
+	});
+	var fired = [];
+
+	for (var i = 0; i < sorted.length; i++) {
+		predictor.update(sorted[i].time, sorted[i].value);
+		var alert = engine.evaluate({
+			time: sorted[i].time,
+			value: sorted[i].value,
+			predictions: predictor.getPredictions()
+		});
+		if (alert !== ALERT_NONE) {
+			fired.push({ time: sorted[i].time, value: sorted[i].value, alert: alert });
+		}
+	}
+
+	return fired;
+}
+
+module.exports = {
+	ALERT_NONE: ALERT_NONE,
+	ALERT_LOW_SOON: ALERT_LOW_SOON,
+	ALERT_HIGH: ALERT_HIGH,
+	AlertEngine: AlertEngine,
+	rulesFromSettings: rulesFromSettings,
+	replay: replay
+};
@@ -3,6 +3,34 @@ module.exports = [
 		type: "heading",
 		defaultValue: "T1000 CGM Settings"
 	},
+	{
+		type: "section",
+		items: [
+			{
+				type: "heading",
+				defaultValue: "Data Source"
+			},
+			{
+				type: "select",
+				messageKey: "source",
+				label: "Glucose Data Source",
+				defaultValue: "dexcom",
+				options: [
+					{ label: "Dexcom Share", value: "dexcom" },
+					{ label: "Nightscout", value: "nightscout" }
+				]
+			},
+			{
+				type: "input",
+				messageKey: "accountLabel",
+				label: "Name on Watch",
+				attributes: {
+					placeholder: "Optional, shown when following several accounts",
+					maxlength: 9
+				}
+			}
+		]
+	},
 	{
 		type: "section",
 		items: [
@@ -41,6 +69,109 @@ module.exports = [
 			}
 		]
 	},
+	{
+		type: "section",
+		items: [
+			{
+				type: "heading",
+				defaultValue: "Nightscout"
+			},
+			{
+				type: "input",
+				messageKey: "nightscoutUrl",
+				label: "Site URL",
+				attributes: {
+					placeholder: "https://example.herokuapp.com",
+					type: "url",
+					autocapitalize: "off",
+					autocorrect: "off"
+				}
+			},
+			{
+				type: "input",
+				messageKey: "nightscoutToken",
+				label: "Access Token",
+				attributes: {
+					placeholder: "Optional read-only token",
+					autocapitalize: "off",
+					autocorrect: "off"
+				}
+			},
+			{
+				type: "text",
+				defaultValue: "<small>Only used when the data source is Nightscout</small>"
+			}
+		]
+	},
+	{
+		type: "section",
+		items: [
+			{
+				type: "heading",
+				defaultValue: "Additional Followers"
+			},
+			{
+				type: "input",
+				messageKey: "follower1AccountName",
+				label: "Follower 1 Username",
+				attributes: {
+					placeholder: "Dexcom Share username",
+					autocapitalize: "off",
+					autocorrect: "off"
+				}
+			},
+			{
+				type: "input",
+				messageKey: "follower1Password",
+				label: "Follower 1 Password",
+				attributes: {
+					placeholder: "Dexcom Share password",
+					type: "password"
+				}
+			},
+			{
+				type: "input",
+				messageKey: "follower1Label",
+				label: "Follower 1 Name on Watch",
+				attributes: {
+					placeholder: "Defaults to the username",
+					maxlength: 9
+				}
+			},
+			{
+				type: "input",
+				messageKey: "follower2AccountName",
+				label: "Follower 2 Username",
+				attributes: {
+					placeholder: "Dexcom Share username",
+					autocapitalize: "off",
+					autocorrect: "off"
+				}
+			},
+			{
+				type: "input",
+				messageKey: "follower2Password",
+				label: "Follower 2 Password",
+				attributes: {
+					placeholder: "Dexcom Share password",
+					type: "password"
+				}
+			},
+			{
+				type: "input",
+				messageKey: "follower2Label",
+				label: "Follower 2 Name on Watch",
+				attributes: {
+					placeholder: "Defaults to the username",
+					maxlength: 9
+				}
+			},
+			{
+				type: "text",
+				defaultValue: "<small>Optional: other Dexcom Share accounts to follow, on the server region above. Tap the watch to switch between accounts</small>"
+			}
+		]
+	},
 	{
 		type: "section",
 		items: [
@@ -54,6 +185,24 @@ module.exports = [
 				label: "Reversed (black on white)",
 				defaultValue: false
 			},
+			{
+				type: "select",
+				messageKey: "defaultView",
+				label: "Chart Area",
+				defaultValue: "chart",
+				options: [
+					{ label: "2 hour chart", value: "chart" },
+					{ label: "12 hour chart", value: "long" },
+					{ label: "24 hour stats", value: "stats" }
+				]
+			},
+			{
+				type: "toggle",
+				messageKey: "showBands",
+				label: "Typical Range Band",
+				description: "Shades the 10th-90th and 25th-75th percentiles for each hour of the day over the last two weeks",
+				defaultValue: false
+			},
 			{
 				type: "select",
 				messageKey: "unit",
@@ -175,6 +324,34 @@ module.exports = [
 			}
 		]
 	},
+	{
+		type: "section",
+		items: [
+			{
+				type: "heading",
+				defaultValue: "Stale Data Alarm"
+			},
+			{
+				type: "toggle",
+				messageKey: "vibeStaleEnabled",
+				label: "Enable stale data alarm vibration",
+				defaultValue: false
+			},
+			{
+				type: "slider",
+				messageKey: "vibeStaleMinutes",
+				label: "Data Age (minutes)",
+				defaultValue: 30,
+				min: 15,
+				max: 120,
+				step: 15
+			},
+			{
+				type: "text",
+				defaultValue: "<small>The watch vibrates by itself when the latest reading gets this old, even if the phone is off or out of range</small>"
+			}
+		]
+	},
 	{
 		type: "section",
 		items: [
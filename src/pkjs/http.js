@@ -0,0 +1,58 @@
+/**
+ * T1000 CGM Watchface - HTTP helper
+ */
+
+/**
+ * Make HTTP request with promise
+ */
+function httpRequest(method, url, body, headers) {
+	return new Promise(function (resolve, reject) {
+		var xhr = new XMLHttpRequest();
+		xhr.open(method, url, true);
+
+		// Set headers
+		xhr.setRequestHeader("Content-Type", "application/json");
+		xhr.setRequestHeader("Accept", "application/json");
+		xhr.setRequestHeader("User-Agent", "Dexcom Share/3.0.2.11 CFNetwork/711.2.23 Darwin/14.0.0");
+
+		if (headers) {
+			for (var key in headers) {
+				xhr.setRequestHeader(key, headers[key]);
+			}
+		}
+
+		xhr.onload = function () {
+			if (xhr.status >= 200 && xhr.status < 300) {
+				try {
+					var response = JSON.parse(xhr.responseText);
+					resolve(response);
+				} catch (e) {
+					// Response might be a plain string (like session ID)
+					resolve(xhr.responseText.replace(/"/g, ""));
+				}
+			} else {
+				reject(new Error("HTTP " + xhr.status + ": " + xhr.statusText));
+			}
+		};
+
+		xhr.onerror = function () {
+			reject(new Error("Network error"));
+		};
+
+		xhr.ontimeout = function () {
+			reject(new Error("Request timeout"));
+		};
+
+		xhr.timeout = 30000; // 30 second timeout
+
+		if (body) {
+			xhr.send(JSON.stringify(body));
+		} else {
+			xhr.send();
+		}
+	});
+}
+
+module.exports = {
+	httpRequest: httpRequest
+};
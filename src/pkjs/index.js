@@ -2,7 +2,12 @@
  * T1000 CGM Watchface - PebbleKit JS
  *
  * Handles Dexcom Share authentication, data fetching, and smart polling.
- * Polls at 5 minutes + 45 seconds after last good reading to minimize battery usage.
+ * Polls just after the next reading is expected to appear on Share, learning the
+ * sensor-to-Share upload latency over time to minimize staleness and empty polls.
+ *
+ * Several accounts can be followed: the main data source plus additional Share
+ * accounts. Each has its own reading store, poll schedule and backoff and is fetched
+ * concurrently with the others; sessions are pooled by credentials.
  */
 
 // Import Clay for configuration
@@ -10,9 +15,17 @@ var Clay = require("pebble-clay");
 var clayConfig = require("./config");
 var clay = new Clay(clayConfig, null, { autoHandleEvents: false });
 
+// Glucose data sources (Dexcom Share, Nightscout) and HTTP helper
+var http = require("./http");
+var Sources = require("./sources");
+
+// Glucose prediction (Kalman filter on level and slope) and rule-based alerts
+var Prediction = require("./prediction");
+var Percentiles = require("./percentiles");
+var Alerts = require("./alerts");
+
 // AppMessage keys (must match appinfo.json and main.c)
 var KEY_CGM_VALUE = 0;
-var KEY_CGM_DELTA = 1;
 var KEY_CGM_TREND = 2;
 var KEY_CGM_TIME_AGO = 3;
 var KEY_CGM_HISTORY = 4;
@@ -24,40 +37,91 @@ var KEY_NEEDS_SETUP = 9;
 var KEY_REVERSED = 10;
 var KEY_SYNC_ERROR = 11;
 var KEY_MEAL_DATA = 12;
-
-// Dexcom Share API endpoints
-var DEXCOM_URLS = {
-	us: "https://share1.dexcom.com",
-	international: "https://shareous1.dexcom.com"
-};
-
-// Dexcom application ID (same as official Dexcom app uses)
-var DEXCOM_APP_ID = "d89443d2-327c-4a6f-89e5-496bbb0317db";
-
-// Trend direction mapping (Dexcom values)
-var TREND_DIRECTIONS = {
-	None: 0,
-	DoubleUp: 1,
-	SingleUp: 2,
-	FortyFiveUp: 3,
-	Flat: 4,
-	FortyFiveDown: 5,
-	SingleDown: 6,
-	DoubleDown: 7,
-	"NOT COMPUTABLE": 0,
-	"RATE OUT OF RANGE": 0
-};
+var KEY_DEFAULT_VIEW = 13;
+var KEY_PREDICTION = 14;
+var KEY_BANDS = 15;
+var KEY_ACCOUNT = 16;
+var KEY_ACCOUNT_COUNT = 17;
+var KEY_ACCOUNT_LABEL = 18;
+var KEY_UNIT = 19;
+var KEY_STALE_ALARM = 20;
+var KEY_ALERT_ID = 21;
+
+// KEY_DEFAULT_VIEW values, matching VIEW_* in main.c
+var VIEW_VALUES = { chart: 0, stats: 1, long: 2 };
+
+// Additional Share accounts that can be followed (the watch holds 1 + FOLLOWER_COUNT)
+var FOLLOWER_COUNT = 2;
+var LABEL_MAX_BYTES = 9; // UTF-8 bytes the watch keeps of a label (ACCOUNT_LABEL_LENGTH in main.c)
+
+// Readings replayed into the predictor when the store is loaded
+var PREDICTION_WARMUP_MS = 60 * 60 * 1000;
+
+// Readings kept for the chart (24 * 5 = 120 minutes, more where the watch's chart is
+// wider; must match CHART_MAX_POINTS in main.c) and the full fetch window
+var CHART_POINTS_DEFAULT = 24;
+var CHART_POINTS_BY_PLATFORM = { emery: 32 };
+var FULL_FETCH_MINUTES = 1440;
+var READING_RETENTION_MS = 24 * 60 * 60 * 1000; // Normalized readings kept in the store
+
+// Percentile bands are re-sent once any of them moves this far (mg/dL)
+var BAND_RESEND_MGDL = 6;
+
+// Saltie meals: minimum time between refreshes, and max extra wait for them after Dexcom returns
+var SALTIE_REFRESH_MS = 10 * 60 * 1000;
+var SALTIE_JOIN_TIMEOUT_MS = 3000;
+
+// Poll scheduling
+var READING_INTERVAL_MS = 5 * 60 * 1000; // Dexcom produces a reading every 5 minutes
+var MAX_FOLLOW_UP_POLLS = 2; // Retries per expected reading before waiting for the next one
+var MIN_FOLLOW_UP_MS = 15000;
+var MAX_FOLLOW_UP_MS = 60000;
+
+// Failure handling: exponential backoff with jitter, and a circuit breaker that
+// stops re-login attempts after repeated auth failures
+var BACKOFF_BASE_MS = { network: 30000, auth: 2 * 60000 };
+var BACKOFF_MAX_MS = { network: 10 * 60000, auth: 30 * 60000 };
+var AUTH_FAILURES_BEFORE_OPEN = 3;
+var CIRCUIT_COOLDOWN_MS = 30 * 60000;
+
+// Alert delivery: each alert goes in its own small message and is resent with backoff
+// until the watch acks its id. One still unacked when it expires is taken back so the
+// next reading can raise it again.
+var ALERT_ACK_TIMEOUT_MS = 5000;
+var ALERT_RETRY_MAX_MS = 60000;
+var ALERT_EXPIRE_MS = 15 * 60 * 1000;
+
+// Initial upload latency estimate, refined per account from its polls
+var LATENCY_MEAN_MS = 45000;
+var LATENCY_DEV_MS = 15000;
+var LATENCY_PROBE_STEP_MS = 1000; // How much earlier to poll after a reading was there on the first try
 
 // State
-var sessionId = null;
-var lastGoodReadingTime = null;
-var pollTimer = null;
+var accounts = []; // Followed accounts, the main data source first (see createAccount)
+var sessionPool = {}; // Data source sessions by credential key (persisted)
+var pendingLogins = {}; // Login promise in flight by credential key
+var sentAccountCount = null; // Account count last sent to the watch
+var fetchGeneration = 0; // Bumped when settings change to invalidate in-flight fetches
+var pendingAlerts = []; // Alerts waiting for the watch's ack (see queueAlert)
+var maxReadings = CHART_POINTS_DEFAULT; // Chart points for the connected watch
 var settings = {
+	source: "dexcom",
 	accountName: "",
 	password: "",
 	server: "us",
+	nightscoutUrl: "",
+	nightscoutToken: "",
+	accountLabel: "",
+	follower1Label: "",
+	follower1AccountName: "",
+	follower1Password: "",
+	follower2Label: "",
+	follower2AccountName: "",
+	follower2Password: "",
 	unit: "mgdl",
 	reversed: false,
+	defaultView: "chart",
+	showBands: false,
 	highThreshold: 180,
 	lowThreshold: 70,
 	vibeLowSoonEnabled: false,
@@ -67,288 +131,728 @@ var settings = {
 	vibeHighThreshold: 250,
 	vibeDelayMinutes: 60,
 	vibeRepeatMinutes: 60,
+	vibeStaleEnabled: false,
+	vibeStaleMinutes: 30,
 	saltieApiToken: ""
 };
 
-// Vibration state (persisted to localStorage to survive app restarts)
-var vibeHighConditionStartTime = null;
-var lastHighVibeTime = null;
-var lastLowSoonVibeTime = null;
+// Time-of-day percentile bands for the main account (persisted), and the encoding
+// last delivered to the watch
+var bands = null;
+var lastSentBands = null;
+
+/**
+ * Create the state for one followed account
+ * Everything here is per account; it's persisted under the usual localStorage keys
+ * with the account's id appended (the main account's id is "", so its keys are unchanged).
+ */
+function createAccount(id) {
+	return {
+		id: id,
+		index: 0, // Position on the watch (0 = main account)
+		label: "",
+		source: null, // Data source (see sources.js)
+		lastGoodReadingTime: null,
+		sentReadingTime: null, // Latest reading the watch confirmed receiving
+		readingStore: [], // Normalized { time, value, trend } readings, most recent first
+		predictor: new Prediction.Predictor(),
+		trajectoryCache: { time: null, points: [] }, // Projection for the predictor's latest reading
+		alertEngine: null, // State persisted to localStorage to survive app restarts
+		pollTimer: null,
+		inFlightFetch: null, // Promise for the fetch currently in progress
+
+		// Upload latency estimate: how long after its timestamp a reading shows up on Share
+		// Rolling mean and mean deviation (same smoothing as TCP's RTT estimator)
+		latencyMean: LATENCY_MEAN_MS,
+		latencyDev: LATENCY_DEV_MS,
+		latencySamples: 0,
+		emptyPollCount: 0, // Polls since the last new reading that found nothing new
+		lastEmptyPollTime: null,
+
+		// Failure state (persisted so a JS restart doesn't restart a login storm)
+		consecutiveFailures: 0,
+		consecutiveAuthFailures: 0,
+		nextAllowedFetchTime: 0, // No network requests before this time (backoff / open circuit)
+		circuitOpen: false,
+		lastErrorText: null
+	};
+}
+
+/**
+ * localStorage key for a piece of an account's state
+ */
+function storageKey(account, name) {
+	return name + account.id;
+}
+
+/**
+ * Log a message, naming the account when following several
+ */
+function log(account, text) {
+	console.log(accounts.length > 1 ? "[" + account.label + "] " + text : text);
+}
 
 /**
- * Load persisted vibration state from localStorage
+ * Load persisted alert engine state from localStorage
+ * Migrates the vibe-state entry written by earlier versions.
  */
-function loadVibeState() {
-	var stored = localStorage.getItem("vibe-state");
+function loadAlertState(account) {
+	var state = null;
+	var stored = localStorage.getItem(storageKey(account, "alert-state"));
+	if (stored) {
+		try {
+			state = JSON.parse(stored);
+		} catch (e) {
+			log(account, "Error parsing alert state: " + e);
+		}
+	}
+
+	var legacy = account.id === "" ? localStorage.getItem("vibe-state") : null;
+	if (!state && legacy) {
+		try {
+			var parsed = JSON.parse(legacy);
+			state = {
+				lastEventTime: null,
+				rules: {
+					lowSoon: { active: false, activeSince: null, lastFired: parsed.lastLowSoonVibeTime || null },
+					high: {
+						active: !!parsed.vibeHighConditionStartTime,
+						activeSince: parsed.vibeHighConditionStartTime || null,
+						lastFired: parsed.lastHighVibeTime || null
+					}
+				}
+			};
+		} catch (e) {
+			console.log("Error parsing vibe state: " + e);
+		}
+		localStorage.removeItem("vibe-state");
+	}
+
+	account.alertEngine = new Alerts.AlertEngine(Alerts.rulesFromSettings(settings), state);
+	log(account, "Alert state loaded: " + JSON.stringify(account.alertEngine.serialize()));
+}
+
+/**
+ * Save alert engine state to localStorage if it changed
+ */
+function saveAlertState(account) {
+	if (!account.alertEngine.needsSave()) {
+		return;
+	}
+	localStorage.setItem(storageKey(account, "alert-state"), JSON.stringify(account.alertEngine.serialize()));
+	account.alertEngine.markSaved();
+}
+
+/**
+ * Load persisted upload latency estimate from localStorage
+ */
+function loadLatencyState(account) {
+	var stored = localStorage.getItem(storageKey(account, "poll-latency"));
 	if (stored) {
 		try {
 			var parsed = JSON.parse(stored);
-			vibeHighConditionStartTime = parsed.vibeHighConditionStartTime || null;
-			lastHighVibeTime = parsed.lastHighVibeTime || null;
-			lastLowSoonVibeTime = parsed.lastLowSoonVibeTime || null;
-			console.log(
-				"Vibe state loaded: highStart=" +
-					vibeHighConditionStartTime +
-					", lastHigh=" +
-					lastHighVibeTime +
-					", lastLowSoon=" +
-					lastLowSoonVibeTime
+			account.latencyMean = parsed.mean || account.latencyMean;
+			account.latencyDev = parsed.dev || account.latencyDev;
+			account.latencySamples = parsed.samples || 0;
+			log(
+				account,
+				"Latency estimate loaded: mean=" +
+					Math.round(account.latencyMean / 1000) +
+					"s, dev=" +
+					Math.round(account.latencyDev / 1000) +
+					"s, samples=" +
+					account.latencySamples
 			);
 		} catch (e) {
-			console.log("Error parsing vibe state: " + e);
+			log(account, "Error parsing latency state: " + e);
 		}
 	}
 }
 
 /**
- * Save vibration state to localStorage
+ * Save upload latency estimate to localStorage
  */
-function saveVibeState() {
+function saveLatencyState(account) {
 	var state = {
-		vibeHighConditionStartTime: vibeHighConditionStartTime,
-		lastHighVibeTime: lastHighVibeTime,
-		lastLowSoonVibeTime: lastLowSoonVibeTime
+		mean: account.latencyMean,
+		dev: account.latencyDev,
+		samples: account.latencySamples
 	};
-	localStorage.setItem("vibe-state", JSON.stringify(state));
+	localStorage.setItem(storageKey(account, "poll-latency"), JSON.stringify(state));
 }
 
 /**
- * Cache CGM readings to localStorage
+ * Record the outcome of a poll for the latency estimate
+ * A new reading bounds its upload latency between the last empty poll and now;
+ * the midpoint of that window is used as the sample. A reading found on the first
+ * poll only bounds it from above (by the offset the estimate itself scheduled), so
+ * the estimate moves a step earlier instead, until a poll comes up empty.
  */
-function cacheReadings(readings) {
-	if (!readings || readings.length === 0) {
+function recordPollResult(account, previousReadingTime, latestTimestamp) {
+	var now = Date.now();
+
+	if (previousReadingTime && latestTimestamp <= previousReadingTime) {
+		account.emptyPollCount++;
+		account.lastEmptyPollTime = now;
 		return;
 	}
-	var cache = {
-		readings: readings,
-		cachedAt: Date.now()
+
+	// Only learn from the reading directly following one we already had,
+	// otherwise we don't know when it actually became available
+	var isNextReading =
+		previousReadingTime && latestTimestamp - previousReadingTime <= READING_INTERVAL_MS + 2 * 60000;
+	if (isNextReading) {
+		var upperBound = now - latestTimestamp;
+		var hasLowerBound = account.lastEmptyPollTime && account.lastEmptyPollTime > latestTimestamp;
+
+		if (!hasLowerBound) {
+			account.latencyMean = Math.max(0, Math.min(account.latencyMean, upperBound) - LATENCY_PROBE_STEP_MS);
+			saveLatencyState(account);
+			log(
+				account,
+				"Reading found on the first poll, latency mean now " + Math.round(account.latencyMean / 1000) + "s"
+			);
+		} else if (upperBound < READING_INTERVAL_MS) {
+			var lowerBound = account.lastEmptyPollTime - latestTimestamp;
+			var sample = (lowerBound + upperBound) / 2;
+			var error = sample - account.latencyMean;
+			account.latencyMean += error / 8;
+			// Deviation is how far the mean was outside the window (the window's own width
+			// isn't an error, and counting it would widen the follow-up polls that set it)
+			var miss = Math.max(0, Math.abs(error) - (upperBound - lowerBound) / 2);
+			account.latencyDev += (miss - account.latencyDev) / 4;
+			account.latencySamples++;
+			saveLatencyState(account);
+			log(
+				account,
+				"Upload latency sample " +
+					Math.round(sample / 1000) +
+					"s (mean " +
+					Math.round(account.latencyMean / 1000) +
+					"s, dev " +
+					Math.round(account.latencyDev / 1000) +
+					"s)"
+			);
+		}
+	}
+
+	account.emptyPollCount = 0;
+	account.lastEmptyPollTime = null;
+}
+
+/**
+ * Load persisted failure/backoff state from localStorage
+ */
+function loadFailureState(account) {
+	var stored = localStorage.getItem(storageKey(account, "fetch-failures"));
+	if (stored) {
+		try {
+			var parsed = JSON.parse(stored);
+			account.consecutiveFailures = parsed.consecutiveFailures || 0;
+			account.consecutiveAuthFailures = parsed.consecutiveAuthFailures || 0;
+			account.nextAllowedFetchTime = parsed.nextAllowedFetchTime || 0;
+			account.circuitOpen = !!parsed.circuitOpen;
+			account.lastErrorText = parsed.lastErrorText || null;
+			if (account.consecutiveFailures > 0) {
+				log(
+					account,
+					"Failure state loaded: failures=" +
+						account.consecutiveFailures +
+						", circuitOpen=" +
+						account.circuitOpen +
+						", retry in " +
+						Math.max(0, Math.round((account.nextAllowedFetchTime - Date.now()) / 1000)) +
+						"s"
+				);
+			}
+		} catch (e) {
+			log(account, "Error parsing failure state: " + e);
+		}
+	}
+}
+
+/**
+ * Save failure/backoff state to localStorage
+ */
+function saveFailureState(account) {
+	var state = {
+		consecutiveFailures: account.consecutiveFailures,
+		consecutiveAuthFailures: account.consecutiveAuthFailures,
+		nextAllowedFetchTime: account.nextAllowedFetchTime,
+		circuitOpen: account.circuitOpen,
+		lastErrorText: account.lastErrorText
 	};
-	localStorage.setItem("cgm-cache", JSON.stringify(cache));
-	console.log("Cached " + readings.length + " readings");
+	localStorage.setItem(storageKey(account, "fetch-failures"), JSON.stringify(state));
 }
 
 /**
- * Get cached readings if still valid (latest reading is less than 5 minutes old)
- * Returns null if cache is invalid or stale
+ * Clear failure state after a successful fetch or a settings change
  */
-function getCachedReadings() {
-	var stored = localStorage.getItem("cgm-cache");
-	if (!stored) {
-		return null;
+function resetFailureState(account) {
+	if (account.consecutiveFailures === 0 && !account.circuitOpen) {
+		return;
 	}
+	if (account.circuitOpen) {
+		log(account, "Circuit closed");
+	}
+	account.consecutiveFailures = 0;
+	account.consecutiveAuthFailures = 0;
+	account.nextAllowedFetchTime = 0;
+	account.circuitOpen = false;
+	account.lastErrorText = null;
+	saveFailureState(account);
+}
 
-	try {
-		var cache = JSON.parse(stored);
-		if (!cache.readings || cache.readings.length === 0) {
-			return null;
+/**
+ * Record a failed fetch, tell the watch and schedule the retry
+ * Auth failures back off more slowly and open the circuit after repeated failures;
+ * once the cool-down passes, a single probe request tests recovery.
+ */
+function recordFetchFailure(account, isAuthError, errorText) {
+	sendError(account, errorText);
+	account.consecutiveFailures++;
+	account.consecutiveAuthFailures = isAuthError ? account.consecutiveAuthFailures + 1 : 0;
+	account.lastErrorText = errorText;
+
+	var delay;
+	if (isAuthError && account.consecutiveAuthFailures >= AUTH_FAILURES_BEFORE_OPEN) {
+		account.circuitOpen = true;
+		// +/- 10% jitter so multiple phones don't probe in lockstep
+		delay = CIRCUIT_COOLDOWN_MS * (0.9 + Math.random() * 0.2);
+		log(account, "Circuit open after " + account.consecutiveAuthFailures + " auth failures");
+	} else {
+		var type = isAuthError ? "auth" : "network";
+		var backoff = Math.min(
+			BACKOFF_MAX_MS[type],
+			BACKOFF_BASE_MS[type] * Math.pow(2, account.consecutiveFailures - 1)
+		);
+		// Equal jitter: half fixed, half random
+		delay = backoff / 2 + Math.random() * (backoff / 2);
+	}
+
+	account.nextAllowedFetchTime = Date.now() + delay;
+	saveFailureState(account);
+
+	log(account, "Retrying in " + Math.round(delay / 1000) + "s (failure " + account.consecutiveFailures + ")");
+	setPollTimer(account, delay);
+}
+
+/**
+ * (Re)start an account's poll timer
+ */
+function setPollTimer(account, delay) {
+	if (account.pollTimer) {
+		clearTimeout(account.pollTimer);
+	}
+	account.pollTimer = setTimeout(function () {
+		fetchData(account);
+	}, delay);
+}
+
+/**
+ * Load the percentile bands from localStorage
+ * The first time, they're seeded from the main account's reading store (must be loaded first).
+ */
+function loadBands() {
+	var state = null;
+	var stored = localStorage.getItem("percentile-bands");
+	if (stored) {
+		try {
+			state = JSON.parse(stored);
+		} catch (e) {
+			console.log("Error parsing percentile bands: " + e);
 		}
+	}
 
-		// Check if the latest reading's timestamp is less than 5 minutes old
-		var latestTimestamp = parseDexcomTimestamp(cache.readings[0].WT);
-		if (!latestTimestamp) {
-			return null;
+	bands = new Percentiles.Bands(state);
+	if (!state) {
+		var readingStore = accounts[0].readingStore;
+		for (var i = readingStore.length - 1; i >= 0; i--) {
+			bands.update(readingStore[i].time, readingStore[i].value);
 		}
+		saveBands();
+	}
+}
 
-		var now = Date.now();
-		var ageMs = now - latestTimestamp;
-		var ageMinutes = ageMs / 60000;
+/**
+ * Save the percentile bands to localStorage if they changed
+ */
+function saveBands() {
+	if (!bands.needsSave()) {
+		return;
+	}
+	localStorage.setItem("percentile-bands", JSON.stringify(bands.serialize()));
+	bands.markSaved();
+}
 
-		if (ageMinutes < 5) {
-			console.log("Using cached readings (latest is " + ageMinutes.toFixed(1) + " min old)");
-			return cache.readings;
-		} else {
-			console.log("Cache stale (latest is " + ageMinutes.toFixed(1) + " min old)");
-			return null;
-		}
-	} catch (e) {
-		console.log("Error parsing CGM cache: " + e);
+/**
+ * Get the bands to send to the watch, or null if it already has them
+ * (re-sent only when a band moves by BAND_RESEND_MGDL or more)
+ */
+function getBandsUpdate() {
+	if (!settings.showBands) {
+		// A single byte clears the bands on the watch
+		return lastSentBands && lastSentBands.length === 1 ? null : [0];
+	}
+
+	var bytes = bands.toBytes();
+	if (lastSentBands && !Percentiles.bytesDiffer(bytes, lastSentBands, BAND_RESEND_MGDL)) {
 		return null;
 	}
+	return bytes;
 }
 
-// Alert types to send to watch
-var ALERT_NONE = 0;
-var ALERT_LOW_SOON = 1;
-var ALERT_HIGH = 2;
-var pendingAlert = ALERT_NONE;
-
 /**
- * Load settings from localStorage (Clay format)
+ * Load the reading store from localStorage
+ * Stored compactly as [time, value, trend] triples, most recent first
  */
-function loadSettings() {
-	var stored = localStorage.getItem("clay-settings");
+function loadReadingStore(account) {
+	var readingStore = [];
+	var stored = localStorage.getItem(storageKey(account, "cgm-readings"));
 	if (stored) {
 		try {
 			var parsed = JSON.parse(stored);
-			for (var key in parsed) {
-				if (settings.hasOwnProperty(key) && parsed[key] !== undefined) {
-					settings[key] = parsed[key];
-				}
+			for (var i = 0; i < parsed.length; i++) {
+				readingStore.push({ time: parsed[i][0], value: parsed[i][1], trend: parsed[i][2] });
 			}
-			console.log("Settings loaded");
 		} catch (e) {
-			console.log("Error parsing settings: " + e);
+			log(account, "Error parsing reading store: " + e);
+			readingStore = [];
+		}
+	}
+	account.readingStore = readingStore;
+
+	// Warm up the predictor from the most recent hour (oldest first)
+	account.predictor.reset();
+	if (readingStore.length > 0) {
+		var warmupStart = readingStore[0].time - PREDICTION_WARMUP_MS;
+		for (var j = readingStore.length - 1; j >= 0; j--) {
+			if (readingStore[j].time >= warmupStart) {
+				account.predictor.update(readingStore[j].time, readingStore[j].value);
+			}
 		}
 	}
+
+	// Migrate the raw Dexcom cache used by earlier versions
+	var legacy = account.id === "" ? localStorage.getItem("cgm-cache") : null;
+	if (legacy) {
+		try {
+			var cache = JSON.parse(legacy);
+			ingestReadings(
+				account,
+				(cache.readings || []).map(Sources.normalizeDexcomReading).filter(function (r) {
+					return r !== null;
+				})
+			);
+		} catch (e) {
+			log(account, "Error parsing CGM cache: " + e);
+		}
+		localStorage.removeItem("cgm-cache");
+	}
+
+	log(account, "Reading store loaded: " + account.readingStore.length + " readings");
 }
 
 /**
- * Save settings to localStorage (Clay format)
+ * Save the reading store to localStorage
  */
-function saveSettings() {
-	localStorage.setItem("clay-settings", JSON.stringify(settings));
+function saveReadingStore(account) {
+	var compact = account.readingStore.map(function (r) {
+		return [r.time, r.value, r.trend];
+	});
+	localStorage.setItem(storageKey(account, "cgm-readings"), JSON.stringify(compact));
 }
 
 /**
- * Get the Dexcom Share base URL based on settings
+ * Merge normalized readings from the data source into the store
+ * Dedupes by timestamp (fresh wins), keeps most recent first and drops readings
+ * older than READING_RETENTION_MS. Returns the number of new readings.
  */
-function getDexcomBaseUrl() {
-	return DEXCOM_URLS[settings.server] || DEXCOM_URLS.us;
+function ingestReadings(account, readings) {
+	var list = Array.isArray(readings) ? readings : [];
+	var readingStore = account.readingStore;
+	var byTime = {};
+	var added = [];
+
+	for (var i = 0; i < readingStore.length; i++) {
+		byTime[readingStore[i].time] = readingStore[i];
+	}
+
+	for (var j = 0; j < list.length; j++) {
+		var reading = list[j];
+		if (!byTime[reading.time]) {
+			added.push(reading);
+		}
+		byTime[reading.time] = reading;
+	}
+
+	var cutoff = Date.now() - READING_RETENTION_MS;
+	var merged = [];
+	for (var time in byTime) {
+		if (byTime[time].time >= cutoff) {
+			merged.push(byTime[time]);
+		}
+	}
+	merged.sort(function (a, b) {
+		return b.time - a.time;
+	});
+
+	var changed = added.length > 0 || merged.length !== readingStore.length;
+	account.readingStore = merged;
+	if (changed) {
+		saveReadingStore(account);
+	}
+
+	// Feed new readings to the predictor oldest first (it ignores backfilled older ones);
+	// the percentile bands follow the main account only
+	var feedBands = bands && account.id === "";
+	added.sort(function (a, b) {
+		return a.time - b.time;
+	});
+	for (var k = 0; k < added.length; k++) {
+		account.predictor.update(added[k].time, added[k].value);
+		if (feedBands) {
+			bands.update(added[k].time, added[k].value);
+		}
+	}
+	if (feedBands) {
+		saveBands();
+	}
+
+	return added.length;
 }
 
 /**
- * Convert mg/dL to mmol/L
+ * Chart points the connected watch holds (its platform decides the chart width)
  */
-function mgdlToMmol(mgdl) {
-	return (mgdl / 18.0182).toFixed(1);
+function getChartPointsForWatch() {
+	var info = Pebble.getActiveWatchInfo ? Pebble.getActiveWatchInfo() : null;
+	return (info && CHART_POINTS_BY_PLATFORM[info.platform]) || CHART_POINTS_DEFAULT;
 }
 
 /**
- * Format glucose value based on unit setting
+ * Get the most recent readings shown on the chart
  */
-function formatGlucose(mgdl) {
-	if (mgdl < 40) {
-		return "LOW";
-	}
-	if (mgdl > 400) {
-		return "HIGH";
+function getChartReadings(account) {
+	return account.readingStore.slice(0, maxReadings);
+}
+
+/**
+ * Get cached readings if still valid (latest reading is less than 5 minutes old)
+ * Returns null if cache is empty or stale
+ */
+function getCachedReadings(account) {
+	if (account.readingStore.length === 0) {
+		return null;
 	}
-	if (settings.unit === "mmol") {
-		return mgdlToMmol(mgdl);
+
+	// Check if the latest reading's timestamp is less than 5 minutes old
+	var ageMinutes = (Date.now() - account.readingStore[0].time) / 60000;
+
+	if (ageMinutes < 5) {
+		log(account, "Using cached readings (latest is " + ageMinutes.toFixed(1) + " min old)");
+		return getChartReadings(account);
+	} else {
+		log(account, "Cache stale (latest is " + ageMinutes.toFixed(1) + " min old)");
+		return null;
 	}
-	return mgdl.toString();
 }
 
 /**
- * Format delta value based on unit setting
+ * Work out how much data to request from Dexcom
+ * Steady state asks only for the readings since the latest one we already have;
+ * a full window is requested on cold start or after an outage longer than the chart
  */
-function formatDelta(deltaMgdl) {
-	var formatted;
-	if (settings.unit === "mmol") {
-		formatted = (deltaMgdl / 18.0182).toFixed(1);
-	} else {
-		formatted = Math.round(deltaMgdl).toString();
+function getFetchWindow(account) {
+	var readingStore = account.readingStore;
+	var full = { minutes: FULL_FETCH_MINUTES, maxCount: maxReadings };
+	if (readingStore.length === 0) {
+		return full;
 	}
-	if (deltaMgdl >= 0) {
-		return "+" + formatted;
+
+	var gapMinutes = (Date.now() - readingStore[0].time) / 60000;
+	if (gapMinutes < 0 || gapMinutes >= maxReadings * 5) {
+		return full;
 	}
-	return formatted;
+
+	// One reading per 5 minutes of gap, plus the latest one again to bridge the boundary
+	return {
+		minutes: Math.ceil(gapMinutes) + 2,
+		maxCount: Math.min(maxReadings, Math.floor(gapMinutes / 5) + 1)
+	};
 }
 
 /**
- * Make HTTP request with promise
+ * Load the session pool from localStorage
+ * Migrates the single dexcom-session entry written by earlier versions.
  */
-function httpRequest(method, url, body, headers) {
-	return new Promise(function (resolve, reject) {
-		var xhr = new XMLHttpRequest();
-		xhr.open(method, url, true);
-
-		// Set headers
-		xhr.setRequestHeader("Content-Type", "application/json");
-		xhr.setRequestHeader("Accept", "application/json");
-		xhr.setRequestHeader("User-Agent", "Dexcom Share/3.0.2.11 CFNetwork/711.2.23 Darwin/14.0.0");
+function loadSessionPool() {
+	sessionPool = {};
+	var stored = localStorage.getItem("dexcom-sessions");
+	if (stored) {
+		try {
+			sessionPool = JSON.parse(stored) || {};
+		} catch (e) {
+			console.log("Error parsing session pool: " + e);
+		}
+	}
 
-		if (headers) {
-			for (var key in headers) {
-				xhr.setRequestHeader(key, headers[key]);
-			}
+	var legacy = localStorage.getItem("dexcom-session");
+	if (legacy) {
+		try {
+			var parsed = JSON.parse(legacy);
+			sessionPool[parsed.credentialKey] = { id: parsed.sessionId, createdAt: parsed.createdAt };
+		} catch (e) {
+			console.log("Error parsing session: " + e);
 		}
+		localStorage.removeItem("dexcom-session");
+	}
+}
 
-		xhr.onload = function () {
-			if (xhr.status >= 200 && xhr.status < 300) {
-				try {
-					var response = JSON.parse(xhr.responseText);
-					resolve(response);
-				} catch (e) {
-					// Response might be a plain string (like session ID)
-					resolve(xhr.responseText.replace(/"/g, ""));
-				}
-			} else {
-				reject(new Error("HTTP " + xhr.status + ": " + xhr.statusText));
-			}
-		};
+/**
+ * Save the session pool to localStorage, dropping sessions no followed account uses
+ */
+function saveSessionPool() {
+	var inUse = {};
+	for (var i = 0; i < accounts.length; i++) {
+		var key = accounts[i].source.getCredentialKey();
+		if (sessionPool[key]) {
+			inUse[key] = sessionPool[key];
+		}
+	}
+	sessionPool = inUse;
+	localStorage.setItem("dexcom-sessions", JSON.stringify(sessionPool));
+}
 
-		xhr.onerror = function () {
-			reject(new Error("Network error"));
-		};
+/**
+ * Give an account the pooled session for its credentials, if there is one that hasn't expired
+ * (another account with the same credentials may have logged in since)
+ */
+function restoreSession(account) {
+	var session = sessionPool[account.source.getCredentialKey()];
+	if (!session) {
+		return;
+	}
+	account.source.restoreSession(session);
+	if (!account.source.hasValidSession()) {
+		log(account, "Stored session expired, discarding");
+		clearSession(account);
+		return;
+	}
+	log(account, "Session loaded (age " + Math.round((Date.now() - session.createdAt) / 60000) + " min)");
+}
 
-		xhr.ontimeout = function () {
-			reject(new Error("Request timeout"));
-		};
+/**
+ * Forget an account's session (in memory and in the pool)
+ */
+function clearSession(account) {
+	var key = account.source.getCredentialKey();
+	account.source.clearSession();
+	if (sessionPool[key]) {
+		delete sessionPool[key];
+		saveSessionPool();
+	}
+}
 
-		xhr.timeout = 30000; // 30 second timeout
+/**
+ * Log a source in, joining a login already in flight for the same credentials
+ * The new session goes into the pool, where every account using them picks it up.
+ */
+function loginShared(loginSource) {
+	var key = loginSource.getCredentialKey();
+	if (pendingLogins[key]) {
+		return pendingLogins[key].then(function (session) {
+			if (session) {
+				loginSource.restoreSession(session);
+			}
+		});
+	}
 
-		if (body) {
-			xhr.send(JSON.stringify(body));
-		} else {
-			xhr.send();
+	var login = loginSource.login().then(
+		function () {
+			delete pendingLogins[key];
+			var session = loginSource.getSession();
+			if (session) {
+				sessionPool[key] = session;
+				saveSessionPool();
+			}
+			return session;
+		},
+		function (error) {
+			delete pendingLogins[key];
+			throw error;
 		}
-	});
+	);
+	pendingLogins[key] = login;
+	return login;
 }
 
 /**
- * Authenticate with Dexcom Share
+ * Load settings from localStorage (Clay format)
  */
-function dexcomLogin() {
-	var baseUrl = getDexcomBaseUrl();
-	var url = baseUrl + "/ShareWebServices/Services/General/LoginPublisherAccountByName";
+function loadSettings() {
+	var stored = localStorage.getItem("clay-settings");
+	if (stored) {
+		try {
+			var parsed = JSON.parse(stored);
+			for (var key in parsed) {
+				if (settings.hasOwnProperty(key) && parsed[key] !== undefined) {
+					settings[key] = parsed[key];
+				}
+			}
+			console.log("Settings loaded");
+		} catch (e) {
+			console.log("Error parsing settings: " + e);
+		}
+	}
+}
 
-	console.log("Logging in to Dexcom Share...");
+/**
+ * Save settings to localStorage (Clay format)
+ */
+function saveSettings() {
+	localStorage.setItem("clay-settings", JSON.stringify(settings));
+}
 
-	return httpRequest("POST", url, {
-		accountName: settings.accountName,
-		password: settings.password,
-		applicationId: DEXCOM_APP_ID
-	}).then(function (response) {
-		sessionId = response;
-		console.log("Login successful, session: " + sessionId.substring(0, 8) + "...");
-		return sessionId;
-	});
+/**
+ * Add the display settings (and the watch's own stale data alarm) to a message
+ * Readings go to the watch in mg/dL; it formats them (and LOW/HIGH) in these units.
+ */
+function addDisplaySettings(message) {
+	message[KEY_LOW_THRESHOLD] = settings.lowThreshold;
+	message[KEY_HIGH_THRESHOLD] = settings.highThreshold;
+	message[KEY_REVERSED] = settings.reversed ? 1 : 0;
+	message[KEY_UNIT] = settings.unit === "mmol" ? 1 : 0;
+	message[KEY_DEFAULT_VIEW] = VIEW_VALUES[settings.defaultView] || 0;
+	message[KEY_STALE_ALARM] = settings.vibeStaleEnabled ? settings.vibeStaleMinutes : 0;
 }
 
 /**
- * Fetch glucose readings from Dexcom Share
+ * Projected trajectory for the latest reading (computed once per reading, not per poll)
  */
-function dexcomFetchReadings() {
-	if (!sessionId) {
-		return Promise.reject(new Error("Not logged in"));
+function getTrajectory(account) {
+	if (account.trajectoryCache.time !== account.predictor.lastTime) {
+		account.trajectoryCache = { time: account.predictor.lastTime, points: account.predictor.getTrajectory() };
 	}
-
-	var baseUrl = getDexcomBaseUrl();
-	// Fetch 24 readings for 120 minutes of data (24 * 5 = 120)
-	var url =
-		baseUrl +
-		"/ShareWebServices/Services/Publisher/ReadPublisherLatestGlucoseValues" +
-		"?sessionID=" +
-		encodeURIComponent(sessionId) +
-		"&minutes=1440" +
-		"&maxCount=24";
-
-	console.log("Fetching glucose readings...");
-
-	return httpRequest("POST", url, null);
+	return account.trajectoryCache.points;
 }
 
 /**
- * Parse Dexcom timestamp
- * Format: "/Date(1234567890000)/"
+ * Get the prediction string for the watch: projected values still in the future
+ * Format: "135:-3,131:-8,..." (mg/dL:minutesAgo, negative = minutes from now)
  */
-function parseDexcomTimestamp(dtString) {
-	var match = dtString.match(/Date\((\d+)\)/);
-	if (match) {
-		return parseInt(match[1], 10);
+function getPredictionString(account, now) {
+	var points = getTrajectory(account);
+	var parts = [];
+
+	for (var i = 0; i < points.length; i++) {
+		var minutesAgo = Math.round((now - (account.trajectoryCache.time + points[i].minutes * 60000)) / 60000);
+		if (minutesAgo < 0) {
+			parts.push(Math.max(1, Math.round(points[i].value)) + ":" + minutesAgo);
+		}
 	}
-	return null;
+
+	return parts.join(",");
 }
 
 /**
@@ -396,100 +900,112 @@ function getMealDataString() {
 }
 
 /**
- * Process glucose readings and send to watch
+ * Tag a message with the account it describes
+ * Untagged messages are for the main account, so following a single account adds no
+ * fields (except once after going back to one account, so the watch drops the others).
  */
-function processReadings(readings, fromCache) {
-	if (!readings || readings.length === 0) {
-		console.log("No readings received");
-		sendError("No data");
+function tagMessage(message, account) {
+	if (accounts.length === 1 && sentAccountCount === 1) {
 		return;
 	}
+	message[KEY_ACCOUNT] = account.index;
+	message[KEY_ACCOUNT_COUNT] = accounts.length;
+	if (accounts.length > 1) {
+		message[KEY_ACCOUNT_LABEL] = account.label;
+	}
+	sentAccountCount = accounts.length;
+}
+
+/**
+ * Process an account's glucose readings and send them to the watch
+ */
+function processReadings(account, readings, fromCache) {
+	var isMainAccount = account.id === "";
 
-	// Cache fresh readings from the API
+	// Merge fresh readings from the API into the store (incremental fetches may return
+	// only the newest reading, or nothing if no new reading is available yet)
 	if (!fromCache) {
-		cacheReadings(readings);
+		var added = ingestReadings(account, readings);
+		log(account, "Received " + added + " new readings");
+		readings = getChartReadings(account);
+	}
+
+	if (!readings || readings.length === 0) {
+		log(account, "No readings received");
+		sendError(account, "No data");
+		return;
 	}
 
-	console.log("Processing " + readings.length + " readings" + (fromCache ? " (from cache)" : ""));
+	log(account, "Processing " + readings.length + " readings" + (fromCache ? " (from cache)" : ""));
 
 	// Most recent reading
 	var latest = readings[0];
-	var latestValue = latest.Value;
-	var latestTimestamp = parseDexcomTimestamp(latest.WT);
-	var latestTrendString = latest.Trend || "None";
-	var latestTrend = TREND_DIRECTIONS[latestTrendString] || 0;
-
-	// Handle numeric trend values from API
-	if (typeof latestTrendString === "number") {
-		latestTrend = latestTrendString > 7 ? 0 : latestTrendString;
-	}
+	var latestValue = latest.value;
+	var latestTimestamp = latest.time;
+	var latestTrend = latest.trend;
 
 	// Calculate time ago
 	var now = Date.now();
 	var minutesAgo = Math.round((now - latestTimestamp) / 60000);
 
-	// Calculate delta (difference from previous reading)
-	var delta = 0;
-	if (readings.length > 1) {
-		var previousValue = readings[1].Value;
-		var previousTimestamp = parseDexcomTimestamp(readings[1].WT);
-		var timeDiffMinutes = (latestTimestamp - previousTimestamp) / 60000;
-
-		// Normalize to 5-minute rate
-		if (timeDiffMinutes > 0) {
-			delta = ((latestValue - previousValue) / timeDiffMinutes) * 5;
-		}
-	}
-
-	// Build history string (value:minutesAgo pairs, most recent first)
+	// Build history string (value:minutesAgo pairs in mg/dL, most recent first)
 	// Format: "120:0,125:5,130:10" where second number is minutes ago from now
+	// The watch shows the first value as the current reading (formatted in the display
+	// units) and works out the delta, and the arrow if the source has no trend, from it
 	var history = readings
 		.map(function (r) {
-			var timestamp = parseDexcomTimestamp(r.WT);
-			var minutesAgo = Math.round((now - timestamp) / 60000);
-			return r.Value + ":" + minutesAgo;
+			var minutesAgo = Math.round((now - r.time) / 60000);
+			return r.value + ":" + minutesAgo;
 		})
 		.join(",");
 
-	// Update last good reading time for smart polling
-	lastGoodReadingTime = latestTimestamp;
-
-	// Check vibration conditions (sets pendingAlert if needed)
-	pendingAlert = ALERT_NONE;
-	checkLowSoonAlert(readings);
-	checkVibrationAlert(latestValue);
+	// Learn upload latency from fresh polls, then update last good reading time for smart polling
+	if (!fromCache) {
+		recordPollResult(account, account.lastGoodReadingTime, latestTimestamp);
+	}
+	account.lastGoodReadingTime = latestTimestamp;
 
-	// Fetch fresh Saltie data if token is configured
-	if (settings.saltieApiToken) {
-		fetchSaltieData();
+	// Evaluate alert rules for the latest reading (already-evaluated readings are ignored)
+	var pendingAlert = account.alertEngine.evaluate({
+		time: latestTimestamp,
+		value: latestValue,
+		predictions: account.predictor.getPredictions()
+	});
+	saveAlertState(account);
+	if (pendingAlert !== Alerts.ALERT_NONE) {
+		log(account, "Triggering alert " + pendingAlert + " (value: " + latestValue + ")");
+		// Queued ahead of the data message, so a large payload can't hold it up
+		queueAlert(account, pendingAlert, latestTimestamp);
 	}
 
-	// Get meal data string
-	var mealData = getMealDataString();
+	// Get meal data string (refreshed alongside the main account's fetch in fetchData)
+	var mealData = isMainAccount ? getMealDataString() : "";
 
 	// Send data to watch
 	var message = {};
-	message[KEY_CGM_VALUE] = formatGlucose(latestValue);
-	message[KEY_CGM_DELTA] = formatDelta(delta);
 	message[KEY_CGM_TREND] = latestTrend;
 	message[KEY_CGM_TIME_AGO] = minutesAgo;
 	message[KEY_CGM_HISTORY] = history;
-	message[KEY_CGM_ALERT] = pendingAlert;
-	message[KEY_LOW_THRESHOLD] = settings.lowThreshold;
-	message[KEY_HIGH_THRESHOLD] = settings.highThreshold;
-	message[KEY_REVERSED] = settings.reversed ? 1 : 0;
 	message[KEY_NEEDS_SETUP] = 0;
 	message[KEY_SYNC_ERROR] = 0; // Success - no sync error
-	message[KEY_MEAL_DATA] = mealData;
+	addDisplaySettings(message);
+	message[KEY_PREDICTION] = getPredictionString(account, now);
+	tagMessage(message, account);
+
+	// Meals and percentile bands belong to the main account
+	var bandBytes = null;
+	if (isMainAccount) {
+		message[KEY_MEAL_DATA] = mealData;
+		bandBytes = getBandsUpdate();
+		if (bandBytes) {
+			message[KEY_BANDS] = bandBytes;
+		}
+	}
 
-	console.log(
+	log(
+		account,
 		"Sending: value=" +
 			latestValue +
-			" (" +
-			formatGlucose(latestValue) +
-			"), " +
-			"delta=" +
-			formatDelta(delta) +
 			", trend=" +
 			latestTrend +
 			", " +
@@ -504,274 +1020,415 @@ function processReadings(readings, fromCache) {
 	Pebble.sendAppMessage(
 		message,
 		function () {
-			console.log("Data sent to watch");
+			log(account, "Data sent to watch");
+			account.sentReadingTime = latestTimestamp;
+			if (bandBytes) {
+				lastSentBands = bandBytes;
+			}
 		},
 		function (e) {
-			console.log("Error sending data: " + JSON.stringify(e));
+			log(account, "Error sending data: " + JSON.stringify(e));
 		}
 	);
 
 	// Schedule next poll
-	scheduleNextPoll();
+	scheduleNextPoll(account);
 }
 
 /**
- * Calculate weighted average velocity from recent readings
- * Uses multiple time spans with heavier weighting on recent changes
- * Returns velocity in mg/dL per 5 minutes, or null if insufficient data or gaps detected
+ * Send an account's error message to watch
  */
-function calculateVelocity(readings) {
-	// Need at least 5 readings to calculate velocity
-	if (!readings || readings.length < 5) {
-		return null;
-	}
+function sendError(account, errorText, needsSetup) {
+	var message = {};
+	message[KEY_CGM_VALUE] = 0; // No reading
+	message[KEY_CGM_TREND] = 255; // Special value: hide trend icon
+	message[KEY_CGM_TIME_AGO] = 0;
+	message[KEY_NEEDS_SETUP] = needsSetup ? 1 : 0;
+	// Signal sync error unless this is just a setup issue
+	message[KEY_SYNC_ERROR] = needsSetup ? 0 : 1;
+	tagMessage(message, account);
 
-	// Check that the first 5 values are valid (non-zero) and have no gaps
-	// Each reading should be ~5 minutes apart; allow up to 7 minutes to account for slight delays
-	var maxGapMs = 7 * 60 * 1000; // 7 minutes in milliseconds
-	for (var i = 0; i < 5; i++) {
-		if (!readings[i] || readings[i].Value === 0) {
-			return null;
+	Pebble.sendAppMessage(
+		message,
+		function () {
+			log(account, "Error sent to watch: " + errorText);
+		},
+		function (e) {
+			log(account, "Failed to send error: " + JSON.stringify(e));
 		}
-		// Check gap between consecutive readings (except for the last one)
-		if (i < 4) {
-			var thisTime = parseDexcomTimestamp(readings[i].WT);
-			var nextTime = parseDexcomTimestamp(readings[i + 1].WT);
-			if (!thisTime || !nextTime) {
-				return null;
-			}
-			var gap = thisTime - nextTime; // readings are most-recent-first
-			if (gap > maxGapMs) {
-				console.log(
-					"Velocity calculation skipped: gap of " +
-						Math.round(gap / 60000) +
-						" min between readings " +
-						i +
-						" and " +
-						(i + 1)
-				);
-				return null;
-			}
+	);
+}
+
+/**
+ * Send just the display settings, so the watch redraws what it has
+ * (a unit or color change doesn't need the readings again)
+ */
+function sendDisplaySettings() {
+	var message = {};
+	addDisplaySettings(message);
+
+	Pebble.sendAppMessage(
+		message,
+		function () {
+			console.log("Display settings sent to watch");
+		},
+		function (e) {
+			console.log("Failed to send display settings: " + JSON.stringify(e));
 		}
+	);
+}
+
+/**
+ * Next alert id (persisted, so the watch never sees an id reused after a restart)
+ */
+function nextAlertId() {
+	var id = (parseInt(localStorage.getItem("alert-id"), 10) || 0) + 1;
+	if (id > 0x7fffffff) {
+		id = 1;
 	}
+	localStorage.setItem("alert-id", String(id));
+	return id;
+}
 
-	var bg0 = readings[0].Value;
-	var bg1 = readings[1].Value;
-	var bg2 = readings[2].Value;
-	var bg3 = readings[3].Value;
-	var bg4 = readings[4].Value;
+/**
+ * Queue an alert for the watch and send it
+ * An unacked alert of the same type for the account is replaced by the new one.
+ */
+function queueAlert(account, alert, readingTime) {
+	for (var i = pendingAlerts.length - 1; i >= 0; i--) {
+		if (pendingAlerts[i].account === account && pendingAlerts[i].alert === alert) {
+			clearTimeout(pendingAlerts[i].timer);
+			pendingAlerts.splice(i, 1);
+		}
+	}
 
-	// Weigh newer values more heavily
-	var w1 = 0.29;
-	var w2 = 0.27;
-	var w3 = 0.23;
-	var w4 = 0.21;
+	var entry = {
+		id: nextAlertId(),
+		account: account,
+		alert: alert,
+		readingTime: readingTime,
+		queuedAt: Date.now(),
+		attempts: 0,
+		timer: null
+	};
+	pendingAlerts.push(entry);
+	sendAlert(entry);
+}
 
-	// Calculate velocities over different time spans (per 5-minute interval)
-	var vel1 = bg0 - bg1; // 5-minute change
-	var vel2 = (bg0 - bg2) / 2.0; // 10-minute change, normalized to 5-min
-	var vel3 = (bg0 - bg3) / 3.0; // 15-minute change, normalized to 5-min
-	var vel4 = (bg0 - bg4) / 4.0; // 20-minute change, normalized to 5-min
+/**
+ * Send (or resend) a queued alert, and schedule the next attempt in case no ack comes
+ * A resend of an alert the watch already handled (its ack was lost) is only acked again.
+ */
+function sendAlert(entry) {
+	entry.timer = null;
+	if (Date.now() - entry.queuedAt >= ALERT_EXPIRE_MS) {
+		log(entry.account, "Alert " + entry.id + " was never acked, giving up");
+		dropAlert(entry);
+		entry.account.alertEngine.retract(entry.alert, entry.readingTime);
+		saveAlertState(entry.account);
+		return;
+	}
 
-	// Calculate the weighted average velocity
-	var velocity = vel1 * w1 + vel2 * w2 + vel3 * w3 + vel4 * w4;
+	var message = {};
+	message[KEY_CGM_ALERT] = entry.alert;
+	message[KEY_ALERT_ID] = entry.id;
+	tagMessage(message, entry.account);
 
-	console.log("Weighted average velocity: " + velocity.toFixed(1) + " mg/dL per 5min");
+	entry.attempts++;
+	Pebble.sendAppMessage(
+		message,
+		function () {
+			log(entry.account, "Alert " + entry.id + " sent to watch");
+		},
+		function (e) {
+			log(entry.account, "Failed to send alert " + entry.id + ": " + JSON.stringify(e));
+		}
+	);
 
-	return velocity;
+	var delay = Math.min(ALERT_ACK_TIMEOUT_MS * Math.pow(2, entry.attempts - 1), ALERT_RETRY_MAX_MS);
+	entry.timer = setTimeout(function () {
+		sendAlert(entry);
+	}, delay);
 }
 
 /**
- * Check if "low soon" alert should trigger based on predicted value in 20 minutes
- * Uses weighted average velocity from recent readings for smoother prediction
+ * Stop resending an alert
  */
-function checkLowSoonAlert(readings) {
-	if (!settings.vibeLowSoonEnabled) {
-		return;
+function dropAlert(entry) {
+	clearTimeout(entry.timer);
+	var index = pendingAlerts.indexOf(entry);
+	if (index >= 0) {
+		pendingAlerts.splice(index, 1);
 	}
+}
 
-	var velocity = calculateVelocity(readings);
-	if (velocity === null) {
-		console.log("Low soon alert: insufficient data for velocity calculation");
-		return;
+/**
+ * The watch acked an alert id
+ */
+function ackAlert(id) {
+	for (var i = 0; i < pendingAlerts.length; i++) {
+		if (pendingAlerts[i].id === id) {
+			log(pendingAlerts[i].account, "Alert " + id + " acked after " + pendingAlerts[i].attempts + " attempts");
+			dropAlert(pendingAlerts[i]);
+			return;
+		}
 	}
+}
 
-	var currentValue = readings[0].Value;
-	// velocity is per 5 minutes, so multiply by 4 to get 20-minute prediction
-	var predictedValue = currentValue + velocity * 4;
-	var isLowSoon = predictedValue < settings.vibeLowSoonThreshold;
-	var now = Date.now();
-
-	if (isLowSoon) {
-		// Check if we should vibrate (first time or repeat interval passed)
-		var shouldVibe = false;
-		if (!lastLowSoonVibeTime) {
-			shouldVibe = true;
-		} else {
-			var timeSinceVibe = (now - lastLowSoonVibeTime) / 60000; // minutes
-			if (timeSinceVibe >= settings.vibeLowSoonRepeatMinutes) {
-				shouldVibe = true;
-			}
+/**
+ * Log in to the account's data source, then fetch
+ * A login that completes after the account's credentials changed is not used
+ */
+function loginAndFetch(account, fetchWindow) {
+	var loginSource = account.source;
+	return loginShared(loginSource).then(function () {
+		if (account.source !== loginSource) {
+			throw new Error("Credentials changed during login");
 		}
+		return loginSource.fetchReadings(fetchWindow);
+	});
+}
 
-		if (shouldVibe) {
-			console.log(
-				"Triggering low soon alert vibration (current: " +
-					currentValue +
-					", predicted: " +
-					Math.round(predictedValue) +
-					" in 20min)"
-			);
-			pendingAlert = ALERT_LOW_SOON;
-			lastLowSoonVibeTime = now;
-			saveVibeState();
-		}
+/**
+ * Whether a request failed because the server rejected the credentials or session
+ * (Share answers an expired session with 500 SessionIdNotFound / SessionNotValid)
+ */
+function isAuthFailure(error) {
+	return error.message.indexOf("401") >= 0 || error.message.indexOf("500") >= 0;
+}
+
+/**
+ * Fetch readings, authenticating first if needed and re-authenticating once
+ * if the stored session has been rejected
+ * Other errors keep the session, so a network blip doesn't cost a login.
+ */
+function fetchReadingsWithAuth(account) {
+	var source = account.source;
+	var fetchWindow = getFetchWindow(account);
+
+	// Pick up a session another account with the same credentials created
+	if (!source.hasValidSession()) {
+		restoreSession(account);
+	}
+
+	// If we have a session that isn't due for a refresh, try to fetch directly
+	if (source.hasValidSession()) {
+		return source.fetchReadings(fetchWindow).catch(function (error) {
+			if (!source.needsLogin || !isAuthFailure(error)) {
+				throw error;
+			}
+			log(account, "Session rejected, re-authenticating: " + error.message);
+			clearSession(account);
+			return loginAndFetch(account, fetchWindow);
+		});
 	}
-	// Note: We intentionally do NOT reset lastLowSoonVibeTime when the condition clears.
-	// This ensures that if the user briefly rises above the threshold and then falls back,
-	// they won't get repeated alerts within the repeat interval.
+
+	// Need to login first
+	return loginAndFetch(account, fetchWindow);
 }
 
 /**
- * Check if vibration alert should trigger
+ * Main fetch function - authenticate if needed, then fetch an account's data
+ * Concurrent callers (poll timer, watch request, ready, settings) join the fetch
+ * already in flight instead of starting another login/fetch chain.
  */
-function checkVibrationAlert(value) {
-	if (!settings.vibeEnabled) {
-		return;
+function fetchData(account) {
+	if (account.inFlightFetch) {
+		log(account, "Fetch already in progress, joining");
+		return account.inFlightFetch;
 	}
 
-	var isHighAlert = value >= settings.vibeHighThreshold;
-	var now = Date.now();
+	if (!account.source.isConfigured()) {
+		log(account, "No credentials configured");
+		sendError(account, "Setup", true);
+		return Promise.resolve();
+	}
 
-	if (isHighAlert) {
-		// Start tracking condition if not already
-		if (!vibeHighConditionStartTime) {
-			vibeHighConditionStartTime = now;
-		}
+	// Meals are fetched alongside the main account's readings
+	var fetchMeals = account.id === "" ? fetchSaltieData : Promise.resolve.bind(Promise);
+
+	// Results are dropped if settings change while the request is in flight
+	var generation = fetchGeneration;
 
-		var conditionDuration = (now - vibeHighConditionStartTime) / 60000; // minutes
+	// Check cache first - use cached data if latest reading is less than 5 minutes old
+	var cachedReadings = getCachedReadings(account);
+	if (cachedReadings) {
+		// Meals are usually recent enough that this resolves immediately
+		return trackFetch(
+			account,
+			joinSaltieData(fetchMeals()).then(function () {
+				if (generation !== fetchGeneration) {
+					log(account, "Discarding stale cached result");
+					return;
+				}
+				processReadings(account, cachedReadings, true);
+			})
+		);
+	}
+
+	// Don't touch the network while backing off or while the circuit is open;
+	// the retry timer (or the probe after the cool-down) will fetch again. The watch
+	// already has the error from when the failure was recorded.
+	var now = Date.now();
+	if (now < account.nextAllowedFetchTime) {
+		log(
+			account,
+			(account.circuitOpen ? "Circuit open" : "Backing off") +
+				", next attempt in " +
+				Math.round((account.nextAllowedFetchTime - now) / 1000) +
+				"s"
+		);
+		setPollTimer(account, account.nextAllowedFetchTime - now);
+		return Promise.resolve();
+	}
+	if (account.circuitOpen) {
+		log(account, "Circuit half-open, sending probe request");
+	}
 
-		// Check if delay has passed
-		if (conditionDuration >= settings.vibeDelayMinutes) {
-			// Check if we should vibrate (first time or repeat interval passed)
-			var shouldVibe = false;
-			if (!lastHighVibeTime) {
-				shouldVibe = true;
-			} else {
-				var timeSinceVibe = (now - lastHighVibeTime) / 60000; // minutes
-				if (timeSinceVibe >= settings.vibeRepeatMinutes) {
-					shouldVibe = true;
+	// Fetch meals concurrently so the message carries this cycle's meals
+	var saltieRequest = fetchMeals();
+
+	var request = fetchReadingsWithAuth(account)
+		.then(function (readings) {
+			return joinSaltieData(saltieRequest).then(function () {
+				return readings;
+			});
+		})
+		.then(
+			function (readings) {
+				if (generation !== fetchGeneration) {
+					log(account, "Discarding stale fetch result");
+					return;
+				}
+				resetFailureState(account);
+				processReadings(account, readings);
+			},
+			function (error) {
+				if (generation !== fetchGeneration) {
+					log(account, "Discarding stale fetch error: " + error.message);
+					return;
 				}
+				log(account, "Login/fetch failed: " + error.message);
+				var isAuthError = isAuthFailure(error);
+				var errorText = isAuthError ? "Auth err" : "Net err";
+				recordFetchFailure(account, isAuthError, errorText);
 			}
+		);
 
-			if (shouldVibe) {
-				console.log("Triggering high alert vibration");
-				pendingAlert = ALERT_HIGH;
-				lastHighVibeTime = now;
-				saveVibeState();
-			}
-		}
-	} else {
-		// Reset condition start time when condition clears (so delay timer restarts)
-		// but keep lastHighVibeTime to prevent repeated alerts within repeat interval
-		if (vibeHighConditionStartTime !== null) {
-			vibeHighConditionStartTime = null;
-			saveVibeState();
+	return trackFetch(account, request);
+}
+
+/**
+ * Make a fetch the account's in-flight fetch until it settles, so concurrent callers join it
+ */
+function trackFetch(account, fetch) {
+	var request = fetch.then(function () {
+		if (account.inFlightFetch === request) {
+			account.inFlightFetch = null;
 		}
-	}
+	});
+	account.inFlightFetch = request;
+	return request;
 }
 
 /**
- * Send error message to watch
+ * Fetch every followed account; each runs concurrently on its own cache and backoff
  */
-function sendError(errorText, needsSetup) {
-	var message = {};
-	message[KEY_CGM_VALUE] = "";
-	message[KEY_CGM_DELTA] = "";
-	message[KEY_CGM_TREND] = 255; // Special value: hide trend icon
-	message[KEY_CGM_TIME_AGO] = 0;
-	message[KEY_NEEDS_SETUP] = needsSetup ? 1 : 0;
-	// Signal sync error unless this is just a setup issue
-	message[KEY_SYNC_ERROR] = needsSetup ? 0 : 1;
+function fetchAllAccounts() {
+	return Promise.all(
+		accounts.map(function (account) {
+			return fetchData(account);
+		})
+	);
+}
 
-	Pebble.sendAppMessage(
-		message,
-		function () {
-			console.log("Error sent to watch", errorText);
-		},
-		function (e) {
-			console.log("Failed to send error: " + JSON.stringify(e));
-		}
+/**
+ * Fetch the accounts the watch may be behind on (for its data requests)
+ * An account is skipped when the watch has its latest reading and the next isn't due yet,
+ * since a fetch would only re-send the cached readings.
+ */
+function fetchStaleAccounts() {
+	var now = Date.now();
+	return Promise.all(
+		accounts
+			.filter(function (account) {
+				return !(
+					account.sentReadingTime !== null &&
+					account.sentReadingTime === account.lastGoodReadingTime &&
+					now - account.sentReadingTime < READING_INTERVAL_MS
+				);
+			})
+			.map(function (account) {
+				return fetchData(account);
+			})
 	);
 }
 
 /**
- * Main fetch function - authenticate if needed, then fetch data
+ * Invalidate any fetch in flight so its result can't overwrite newer data
  */
-function fetchData() {
-	if (!settings.accountName || !settings.password) {
-		console.log("No credentials configured");
-		sendError("Setup", true);
-		return;
+function cancelInFlightFetches() {
+	fetchGeneration++;
+	for (var i = 0; i < accounts.length; i++) {
+		accounts[i].inFlightFetch = null;
 	}
+}
 
-	// Check cache first - use cached data if latest reading is less than 5 minutes old
-	var cachedReadings = getCachedReadings();
-	if (cachedReadings) {
-		processReadings(cachedReadings, true);
-		return;
+/**
+ * Check whether the stored Saltie meals need refreshing
+ * Refreshes when the day or token changed, otherwise at most every SALTIE_REFRESH_MS
+ */
+function isSaltieRefreshDue() {
+	var stored = localStorage.getItem("saltie-meta");
+	if (!stored) {
+		return true;
 	}
 
-	// If we have a session, try to fetch directly
-	if (sessionId) {
-		dexcomFetchReadings()
-			.then(processReadings)
-			.catch(function (error) {
-				console.log("Fetch failed, re-authenticating: " + error.message);
-				// Session might be expired, try re-auth
-				sessionId = null;
-				dexcomLogin()
-					.then(dexcomFetchReadings)
-					.then(processReadings)
-					.catch(function (error) {
-						console.log("Re-auth failed: " + error.message);
-						sendError("Auth err");
-					});
-			});
-	} else {
-		// Need to login first
-		dexcomLogin()
-			.then(dexcomFetchReadings)
-			.then(processReadings)
-			.catch(function (error) {
-				console.log("Login/fetch failed: " + error.message);
-				if (error.message.indexOf("401") >= 0 || error.message.indexOf("500") >= 0) {
-					sendError("Auth err");
-				} else {
-					sendError("Net err");
-				}
-			});
+	try {
+		var meta = JSON.parse(stored);
+		var today = new Date().toDateString();
+		if (meta.day !== today || meta.tokenHash !== Sources.hashString(settings.saltieApiToken)) {
+			return true;
+		}
+		return Date.now() - meta.fetchedAt >= SALTIE_REFRESH_MS;
+	} catch (e) {
+		console.log("Error parsing Saltie meta: " + e);
+		return true;
 	}
 }
 
 /**
  * Fetch Saltie meal data
+ * Returns a promise that always resolves (once the meals are stored, or on error)
  */
 function fetchSaltieData() {
 	if (!settings.saltieApiToken) {
-		console.log("No Saltie API token configured");
-		return;
+		return Promise.resolve();
+	}
+
+	if (!isSaltieRefreshDue()) {
+		console.log("Saltie meals are recent, skipping request");
+		return Promise.resolve();
 	}
 
 	console.log("Fetching Saltie meal data...");
 
-	httpRequest("GET", "https://api.saltie.app/api/v1/meals/today", null, {
-		"api-token": settings.saltieApiToken
-	})
+	return http
+		.httpRequest("GET", "https://api.saltie.app/api/v1/meals/today", null, {
+			"api-token": settings.saltieApiToken
+		})
 		.then(function (data) {
 			console.log("Saltie data received: " + JSON.stringify(data));
 			// Store the meal data for future use
 			localStorage.setItem("saltie-meals", JSON.stringify(data));
+			localStorage.setItem(
+				"saltie-meta",
+				JSON.stringify({
+					fetchedAt: Date.now(),
+					day: new Date().toDateString(),
+					tokenHash: Sources.hashString(settings.saltieApiToken)
+				})
+			);
 		})
 		.catch(function (error) {
 			console.log("Saltie API error: " + error.message);
@@ -779,49 +1436,225 @@ function fetchSaltieData() {
 }
 
 /**
- * Schedule next poll based on smart timing
- * Poll at 5 minutes + 45 seconds after last good reading
+ * Wait for the Saltie request, but no longer than SALTIE_JOIN_TIMEOUT_MS
+ * so a slow meals API never delays glucose data
  */
-function scheduleNextPoll() {
-	// Clear any existing timer
-	if (pollTimer) {
-		clearTimeout(pollTimer);
-		pollTimer = null;
-	}
+function joinSaltieData(saltieRequest) {
+	return Promise.race([
+		saltieRequest,
+		new Promise(function (resolve) {
+			setTimeout(function () {
+				resolve();
+			}, SALTIE_JOIN_TIMEOUT_MS);
+		})
+	]);
+}
 
-	if (!lastGoodReadingTime) {
+/**
+ * Schedule next poll based on smart timing
+ * First poll lands just after the next reading is likely to appear on Share
+ * (expected time + learned upload latency), followed by a few short retries
+ * if it isn't there yet.
+ */
+function scheduleNextPoll(account) {
+	if (!account.lastGoodReadingTime) {
 		// No good reading yet, poll every 30 seconds
-		pollTimer = setTimeout(fetchData, 30000);
-		console.log("No reading yet, polling in 30s");
+		setPollTimer(account, 30000);
+		log(account, "No reading yet, polling in 30s");
 		return;
 	}
 
 	var now = Date.now();
+	var arrivalOffset = account.latencyMean + account.latencyDev / 2;
+	var followUpDelay = Math.min(MAX_FOLLOW_UP_MS, Math.max(MIN_FOLLOW_UP_MS, account.latencyDev * 2));
+
+	// Likely arrival time of the next reading we don't have yet
+	var nextPollTime = account.lastGoodReadingTime + READING_INTERVAL_MS + arrivalOffset;
+	var delay;
+
+	if (nextPollTime > now) {
+		delay = nextPollTime - now;
+	} else if (account.emptyPollCount < MAX_FOLLOW_UP_POLLS) {
+		// Reading is late - retry shortly
+		delay = followUpDelay;
+	} else {
+		// Reading was probably skipped, wait for the following expected arrival
+		while (nextPollTime <= now) {
+			nextPollTime += READING_INTERVAL_MS;
+		}
+		delay = nextPollTime - now;
+		account.emptyPollCount = 0;
+	}
+
+	// Minimum 5 seconds
+	if (delay < 5000) {
+		delay = 5000;
+	}
+
+	log(account, "Next poll in " + Math.round(delay / 1000) + "s");
+	setPollTimer(account, delay);
+}
 
-	// Expected next reading: 5 minutes after last reading
-	// We poll at 5 minutes + 30 seconds to give Dexcom time to process
-	var pollInterval = (5 * 60 + 30) * 1000; // 5m 30s in milliseconds
-	var nextPollTime = lastGoodReadingTime + pollInterval;
+/**
+ * The accounts to follow, from the settings: the main data source, then each
+ * additional Share follower with credentials (on the main account's server)
+ * Each carries its own copy of the source settings, so editing the settings
+ * doesn't change a source under a fetch in flight.
+ */
+function getAccountConfigs() {
+	var configs = [
+		{
+			id: "",
+			label: settings.accountLabel,
+			sourceSettings: {
+				source: settings.source,
+				accountName: settings.accountName,
+				password: settings.password,
+				server: settings.server,
+				nightscoutUrl: settings.nightscoutUrl,
+				nightscoutToken: settings.nightscoutToken
+			}
+		}
+	];
+	var seen = { "": true };
+
+	for (var i = 1; i <= FOLLOWER_COUNT; i++) {
+		var accountName = settings["follower" + i + "AccountName"];
+		var password = settings["follower" + i + "Password"];
+		if (!accountName || !password) {
+			continue;
+		}
 
-	// If we've already passed the next poll time, calculate the one after
-	while (nextPollTime <= now) {
-		nextPollTime += pollInterval;
+		// Keyed by account (not password) so a password change keeps the account's history
+		var id = ":" + Sources.hashString(settings.server + ":" + accountName);
+		if (seen[id]) {
+			continue;
+		}
+		seen[id] = true;
+
+		configs.push({
+			id: id,
+			label: settings["follower" + i + "Label"] || accountName,
+			sourceSettings: {
+				source: "dexcom",
+				accountName: accountName,
+				password: password,
+				server: settings.server
+			}
+		});
 	}
 
-	var delay = nextPollTime - now;
+	return configs;
+}
 
-	// Cap at 6 minutes max (in case of drift)
-	if (delay > 6 * 60 * 1000) {
-		delay = 6 * 60 * 1000;
+/**
+ * Load an account's persisted state (the reading store before anything derived from it)
+ */
+function loadAccountState(account) {
+	restoreSession(account);
+	loadReadingStore(account);
+	loadAlertState(account);
+	loadLatencyState(account);
+	loadFailureState(account);
+}
+
+/**
+ * Stop following an account and remove its persisted state
+ */
+function forgetAccount(account) {
+	log(account, "No longer followed, removing its state");
+	if (account.pollTimer) {
+		clearTimeout(account.pollTimer);
+		account.pollTimer = null;
 	}
+	for (var j = pendingAlerts.length - 1; j >= 0; j--) {
+		if (pendingAlerts[j].account === account) {
+			dropAlert(pendingAlerts[j]);
+		}
+	}
+	var names = ["cgm-readings", "poll-latency", "fetch-failures", "alert-state"];
+	for (var i = 0; i < names.length; i++) {
+		localStorage.removeItem(storageKey(account, names[i]));
+	}
+}
 
-	// Minimum 10 seconds
-	if (delay < 10000) {
-		delay = 10000;
+/**
+ * Label shown on the watch: the configured name (or "#n"), cut to whole characters
+ * that fit the watch's label buffer
+ */
+function watchLabel(label, index) {
+	label = label || "#" + (index + 1);
+	var result = "";
+	var bytes = 0;
+	for (var i = 0; i < label.length; i++) {
+		var code = label.charCodeAt(i);
+		var isPair = code >= 0xd800 && code <= 0xdbff && i + 1 < label.length;
+		var size = code < 0x80 ? 1 : code < 0x800 ? 2 : isPair ? 4 : 3;
+		if (bytes + size > LABEL_MAX_BYTES) {
+			break;
+		}
+		result += label.substr(i, isPair ? 2 : 1);
+		bytes += size;
+		if (isPair) {
+			i++;
+		}
 	}
+	return result;
+}
 
-	console.log("Next poll in " + Math.round(delay / 1000) + "s");
-	pollTimer = setTimeout(fetchData, delay);
+/**
+ * Bring the followed accounts in line with the settings
+ * Accounts that are still followed keep their state; an account whose source
+ * credentials changed gets a new source and loses its session.
+ * Returns whether the watch needs the accounts' data again (accounts, labels or
+ * credentials changed).
+ */
+function configureAccounts() {
+	var configs = getAccountConfigs();
+	var changed = configs.length !== accounts.length;
+	var previous = {};
+	for (var i = 0; i < accounts.length; i++) {
+		previous[accounts[i].id] = accounts[i];
+	}
+
+	var next = [];
+	for (var j = 0; j < configs.length; j++) {
+		var config = configs[j];
+		var source = Sources.createSource(config.sourceSettings);
+		var account = previous[config.id];
+
+		if (!account) {
+			account = createAccount(config.id);
+			account.source = source;
+			account.label = watchLabel(config.label, j);
+			loadAccountState(account);
+			changed = true;
+		} else {
+			// Reset the session only if the source, account, password or server actually changed
+			delete previous[config.id];
+			if (source.getCredentialKey() !== account.source.getCredentialKey()) {
+				log(account, "Credentials changed, resetting session");
+				clearSession(account);
+				account.source = source;
+				restoreSession(account);
+				changed = true;
+			}
+		}
+
+		var label = watchLabel(config.label, j);
+		changed = changed || account.index !== j || account.label !== label;
+		account.index = j;
+		account.label = label;
+		next.push(account);
+	}
+
+	for (var id in previous) {
+		forgetAccount(previous[id]);
+	}
+
+	accounts = next;
+	saveSessionPool();
+	return changed;
 }
 
 /**
@@ -831,11 +1664,16 @@ Pebble.addEventListener("showConfiguration", function (e) {
 	console.log("Showing configuration");
 	// Pass current settings to Clay so the form shows saved values
 	var claySettings = {
+		source: settings.source,
 		accountName: settings.accountName,
 		password: settings.password,
 		server: settings.server,
+		nightscoutUrl: settings.nightscoutUrl,
+		nightscoutToken: settings.nightscoutToken,
 		unit: settings.unit,
 		reversed: settings.reversed,
+		defaultView: settings.defaultView,
+		showBands: settings.showBands,
 		lowThreshold: settings.lowThreshold,
 		highThreshold: settings.highThreshold,
 		vibeLowSoonEnabled: settings.vibeLowSoonEnabled,
@@ -845,8 +1683,16 @@ Pebble.addEventListener("showConfiguration", function (e) {
 		vibeHighThreshold: settings.vibeHighThreshold,
 		vibeDelayMinutes: settings.vibeDelayMinutes,
 		vibeRepeatMinutes: settings.vibeRepeatMinutes,
-		saltieApiToken: settings.saltieApiToken
+		vibeStaleEnabled: settings.vibeStaleEnabled,
+		vibeStaleMinutes: settings.vibeStaleMinutes,
+		saltieApiToken: settings.saltieApiToken,
+		accountLabel: settings.accountLabel
 	};
+	for (var i = 1; i <= FOLLOWER_COUNT; i++) {
+		claySettings["follower" + i + "Label"] = settings["follower" + i + "Label"];
+		claySettings["follower" + i + "AccountName"] = settings["follower" + i + "AccountName"];
+		claySettings["follower" + i + "Password"] = settings["follower" + i + "Password"];
+	}
 
 	Pebble.openURL(clay.generateUrl(claySettings));
 });
@@ -862,6 +1708,7 @@ Pebble.addEventListener("webviewclosed", function (e) {
 	}
 
 	var dict;
+	var previousDataSettings = settings.saltieApiToken + ":" + settings.showBands;
 
 	try {
 		dict = JSON.parse(e.response);
@@ -870,11 +1717,16 @@ Pebble.addEventListener("webviewclosed", function (e) {
 	}
 
 	// Update local settings from Clay response
+	if (dict.source !== undefined) settings.source = dict.source.value || "dexcom";
+	if (dict.nightscoutUrl !== undefined) settings.nightscoutUrl = dict.nightscoutUrl.value || "";
+	if (dict.nightscoutToken !== undefined) settings.nightscoutToken = dict.nightscoutToken.value || "";
 	if (dict.accountName !== undefined) settings.accountName = dict.accountName.value || "";
 	if (dict.password !== undefined) settings.password = dict.password.value || "";
 	if (dict.server !== undefined) settings.server = dict.server.value || "us";
 	if (dict.unit !== undefined) settings.unit = dict.unit.value || "mgdl";
 	if (dict.reversed !== undefined) settings.reversed = !!dict.reversed.value;
+	if (dict.defaultView !== undefined) settings.defaultView = dict.defaultView.value || "chart";
+	if (dict.showBands !== undefined) settings.showBands = !!dict.showBands.value;
 	if (dict.highThreshold !== undefined) settings.highThreshold = parseInt(dict.highThreshold.value, 10) || 180;
 	if (dict.lowThreshold !== undefined) settings.lowThreshold = parseInt(dict.lowThreshold.value, 10) || 70;
 	if (dict.vibeLowSoonEnabled !== undefined) settings.vibeLowSoonEnabled = !!dict.vibeLowSoonEnabled.value;
@@ -888,15 +1740,38 @@ Pebble.addEventListener("webviewclosed", function (e) {
 	if (dict.vibeDelayMinutes !== undefined) settings.vibeDelayMinutes = parseInt(dict.vibeDelayMinutes.value, 10) || 60;
 	if (dict.vibeRepeatMinutes !== undefined)
 		settings.vibeRepeatMinutes = parseInt(dict.vibeRepeatMinutes.value, 10) || 60;
+	if (dict.vibeStaleEnabled !== undefined) settings.vibeStaleEnabled = !!dict.vibeStaleEnabled.value;
+	if (dict.vibeStaleMinutes !== undefined) settings.vibeStaleMinutes = parseInt(dict.vibeStaleMinutes.value, 10) || 30;
 	if (dict.saltieApiToken !== undefined) settings.saltieApiToken = dict.saltieApiToken.value || "";
+	if (dict.accountLabel !== undefined) settings.accountLabel = dict.accountLabel.value || "";
+	for (var i = 1; i <= FOLLOWER_COUNT; i++) {
+		var prefix = "follower" + i;
+		if (dict[prefix + "Label"] !== undefined) settings[prefix + "Label"] = dict[prefix + "Label"].value || "";
+		if (dict[prefix + "AccountName"] !== undefined)
+			settings[prefix + "AccountName"] = dict[prefix + "AccountName"].value || "";
+		if (dict[prefix + "Password"] !== undefined) settings[prefix + "Password"] = dict[prefix + "Password"].value || "";
+	}
 
 	saveSettings();
+	var accountsChanged = configureAccounts();
+	for (var j = 0; j < accounts.length; j++) {
+		accounts[j].alertEngine.setRules(Alerts.rulesFromSettings(settings));
+	}
 
-	// Reset session on credential change
-	sessionId = null;
+	// Display-only changes (units, colors, thresholds, view) and the stale data alarm
+	// are applied by the watch
+	if (!accountsChanged && settings.saltieApiToken + ":" + settings.showBands === previousDataSettings) {
+		sendDisplaySettings();
+		return;
+	}
 
-	// Fetch data with new settings
-	fetchData();
+	// Drop any fetch started with the old settings, then fetch with the new ones
+	// (new settings may fix whatever was failing, so clear the backoff too)
+	cancelInFlightFetches();
+	for (var k = 0; k < accounts.length; k++) {
+		resetFailureState(accounts[k]);
+	}
+	fetchAllAccounts();
 });
 
 /**
@@ -904,9 +1779,12 @@ Pebble.addEventListener("webviewclosed", function (e) {
  */
 Pebble.addEventListener("ready", function () {
 	console.log("T1000 PebbleKit JS ready");
+	maxReadings = getChartPointsForWatch();
 	loadSettings();
-	loadVibeState();
-	fetchData();
+	loadSessionPool();
+	configureAccounts();
+	loadBands();
+	fetchAllAccounts();
 });
 
 /**
@@ -915,8 +1793,12 @@ Pebble.addEventListener("ready", function () {
 Pebble.addEventListener("appmessage", function (e) {
 	console.log("Received message from watch");
 
+	if (e.payload[KEY_ALERT_ID]) {
+		ackAlert(e.payload[KEY_ALERT_ID]);
+	}
+
 	if (e.payload[KEY_REQUEST_DATA]) {
 		console.log("Watch requested data update");
-		fetchData();
+		fetchStaleAccounts();
 	}
 });
@@ -0,0 +1,176 @@
+/**
+ * T1000 CGM Watchface - Time-of-day percentile bands (AGP style)
+ *
+ * One streaming quantile estimator per hour of the day: a histogram of readings in
+ * fixed mg/dL bins whose weights decay exponentially with reading age, so the bands
+ * follow roughly the last two weeks in bounded memory. Each reading touches only its
+ * own hour's histogram, and nothing is ever rescanned.
+ */
+
+// Hour-of-day buckets and histogram bins (40-400 mg/dL in 10 mg/dL steps)
+var BUCKETS = 24;
+var BIN_MIN = 40;
+var BIN_WIDTH = 10;
+var BIN_COUNT = 37;
+
+// Weight decay time constant: readings a week old count e^-1, two weeks old e^-2
+var DECAY_MS = 7 * 24 * 60 * 60 * 1000;
+
+// A bucket needs about two days of readings (12 per hour per day) before it has a band
+var MIN_WEIGHT = 24;
+
+// Percentiles per bucket, in the order they're sent to the watch
+var PERCENTILES = [0.1, 0.25, 0.75, 0.9];
+
+// Watch encoding: one byte per percentile, mg/dL / 2 (0 = no band for that hour)
+var BYTES_PER_MGDL = 0.5;
+
+/**
+ * Create empty bands, optionally restoring serialized state
+ */
+function Bands(state) {
+	this.buckets = [];
+	for (var i = 0; i < BUCKETS; i++) {
+		this.buckets.push({ time: null, counts: emptyCounts() });
+	}
+	this.dirty = false;
+
+	if (state && state.buckets && state.buckets.length === BUCKETS) {
+		for (var j = 0; j < BUCKETS; j++) {
+			var saved = state.buckets[j];
+			if (saved && saved.counts && saved.counts.length === BIN_COUNT) {
+				this.buckets[j] = { time: saved.time || null, counts: saved.counts.slice() };
+			}
+		}
+	}
+}
+
+function emptyCounts() {
+	var counts = [];
+	for (var i = 0; i < BIN_COUNT; i++) {
+		counts.push(0);
+	}
+	return counts;
+}
+
+function binOf(value) {
+	var bin = Math.floor((value - BIN_MIN) / BIN_WIDTH);
+	return Math.max(0, Math.min(BIN_COUNT - 1, bin));
+}
+
+/**
+ * Add a reading (time in ms, value in mg/dL)
+ * Newer readings decay the bucket up to their time; backfilled older ones are added
+ * with their own (smaller) weight instead.
+ */
+Bands.prototype.update = function (time, value) {
+	if (!value) {
+		return;
+	}
+
+	var bucket = this.buckets[new Date(time).getHours()];
+	var weight = 1;
+
+	if (bucket.time === null || time >= bucket.time) {
+		if (bucket.time !== null) {
+			var decay = Math.exp(-(time - bucket.time) / DECAY_MS);
+			for (var i = 0; i < BIN_COUNT; i++) {
+				bucket.counts[i] *= decay;
+			}
+		}
+		bucket.time = time;
+	} else {
+		weight = Math.exp(-(bucket.time - time) / DECAY_MS);
+	}
+
+	bucket.counts[binOf(value)] += weight;
+	this.dirty = true;
+};
+
+/**
+ * Percentile of one bucket's histogram, interpolated within the bin
+ * Returns null if the bucket doesn't have enough data
+ */
+Bands.prototype.percentile = function (hour, p) {
+	var counts = this.buckets[hour].counts;
+	var total = 0;
+	for (var i = 0; i < BIN_COUNT; i++) {
+		total += counts[i];
+	}
+	if (total < MIN_WEIGHT) {
+		return null;
+	}
+
+	var target = p * total;
+	var cumulative = 0;
+	for (var j = 0; j < BIN_COUNT; j++) {
+		if (cumulative + counts[j] >= target && counts[j] > 0) {
+			return BIN_MIN + BIN_WIDTH * (j + (target - cumulative) / counts[j]);
+		}
+		cumulative += counts[j];
+	}
+	return BIN_MIN + BIN_WIDTH * BIN_COUNT;
+};
+
+/**
+ * Bands in the watch's format: BUCKETS * PERCENTILES.length bytes, hour by hour
+ */
+Bands.prototype.toBytes = function () {
+	var bytes = [];
+	for (var hour = 0; hour < BUCKETS; hour++) {
+		for (var k = 0; k < PERCENTILES.length; k++) {
+			var value = this.percentile(hour, PERCENTILES[k]);
+			bytes.push(value === null ? 0 : Math.max(1, Math.min(255, Math.round(value * BYTES_PER_MGDL))));
+		}
+	}
+	return bytes;
+};
+
+/**
+ * Whether two encoded bands differ by at least threshold mg/dL anywhere
+ * (or a bucket gained or lost its band)
+ */
+function bytesDiffer(a, b, thresholdMgdl) {
+	if (!a || !b || a.length !== b.length) {
+		return true;
+	}
+	for (var i = 0; i < a.length; i++) {
+		if ((a[i] === 0) !== (b[i] === 0) || Math.abs(a[i] - b[i]) >= thresholdMgdl * BYTES_PER_MGDL) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Whether state changed since the last call to markSaved()
+ */
+Bands.prototype.needsSave = function () {
+	return this.dirty;
+};
+
+Bands.prototype.markSaved = function () {
+	this.dirty = false;
+};
+
+/**
+ * Serializable state (weights rounded, they only feed percentiles)
+ */
+Bands.prototype.serialize = function () {
+	return {
+		buckets: this.buckets.map(function (bucket) {
+			return {
+				time: bucket.time,
+				counts: bucket.counts.map(function (count) {
+					return Math.round(count * 1000) / 1000;
+				})
+			};
+		})
+	};
+};
+
+module.exports = {
+	Bands: Bands,
+	bytesDiffer: bytesDiffer,
+	PERCENTILES: PERCENTILES
+};
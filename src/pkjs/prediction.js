@@ -0,0 +1,172 @@
+/**
+ * T1000 CGM Watchface - Glucose prediction
+ *
+ * Kalman filter on glucose level and slope (constant-velocity model).
+ * Each reading updates the state in constant time, irregular timestamps are handled
+ * by scaling the state transition and process noise by the elapsed time, and long
+ * gaps reset the filter rather than extrapolating across them.
+ */
+
+// Sensor noise variance (mg/dL^2) - Dexcom readings are roughly +/- 5 mg/dL
+var MEASUREMENT_VARIANCE = 25;
+
+// Process noise: how quickly the slope is allowed to change (mg/dL/min^2 spectral density)
+var ACCELERATION_NOISE = 0.01;
+
+// Uncertainty of the slope after a reset (mg/dL/min)^2
+var INITIAL_SLOPE_VARIANCE = 4;
+
+// Gaps longer than this reset the filter
+var MAX_GAP_MINUTES = 30;
+
+// Readings needed after a reset before predictions are reported
+var MIN_READINGS = 3;
+
+// Horizons reported by getPredictions (minutes after the latest reading)
+var PREDICTION_HORIZONS = [10, 20, 30];
+
+// Projected trajectory drawn on the watch: a point every 5 minutes up to 30 minutes ahead
+var TRAJECTORY_STEP_MINUTES = 5;
+var TRAJECTORY_MINUTES = 30;
+
+/**
+ * Create a predictor with no readings
+ */
+function Predictor() {
+	this.reset();
+}
+
+/**
+ * Forget all state (level, slope and covariance)
+ */
+Predictor.prototype.reset = function () {
+	this.level = 0;
+	this.slope = 0; // mg/dL per minute
+	this.p00 = 0;
+	this.p01 = 0;
+	this.p11 = 0;
+	this.lastTime = null;
+	this.count = 0;
+};
+
+/**
+ * Add a reading (time in ms, value in mg/dL)
+ * Readings at or before the latest one are ignored
+ */
+Predictor.prototype.update = function (time, value) {
+	if (!value) {
+		return;
+	}
+
+	if (this.lastTime === null) {
+		this.start(time, value);
+		return;
+	}
+
+	var dt = (time - this.lastTime) / 60000;
+	if (dt <= 0) {
+		return;
+	}
+	if (dt > MAX_GAP_MINUTES) {
+		this.start(time, value);
+		return;
+	}
+
+	// Predict: x = F x, P = F P F' + Q
+	var level = this.level + this.slope * dt;
+	var p00 = this.p00 + 2 * dt * this.p01 + dt * dt * this.p11;
+	var p01 = this.p01 + dt * this.p11;
+	var p11 = this.p11;
+	p00 += (ACCELERATION_NOISE * dt * dt * dt) / 3;
+	p01 += (ACCELERATION_NOISE * dt * dt) / 2;
+	p11 += ACCELERATION_NOISE * dt;
+
+	// Update with the measured level
+	var innovation = value - level;
+	var s = p00 + MEASUREMENT_VARIANCE;
+	var k0 = p00 / s;
+	var k1 = p01 / s;
+
+	this.level = level + k0 * innovation;
+	this.slope = this.slope + k1 * innovation;
+	this.p00 = (1 - k0) * p00;
+	this.p01 = (1 - k0) * p01;
+	this.p11 = p11 - k1 * p01;
+	this.lastTime = time;
+	this.count++;
+};
+
+/**
+ * Restart the filter from a single reading with unknown slope
+ */
+Predictor.prototype.start = function (time, value) {
+	this.level = value;
+	this.slope = 0;
+	this.p00 = MEASUREMENT_VARIANCE;
+	this.p01 = 0;
+	this.p11 = INITIAL_SLOPE_VARIANCE;
+	this.lastTime = time;
+	this.count = 1;
+};
+
+/**
+ * Whether enough consecutive readings have been seen to trust the slope
+ */
+Predictor.prototype.isReady = function () {
+	return this.count >= MIN_READINGS;
+};
+
+/**
+ * Predict the value a number of minutes after the latest reading
+ * Returns { minutes, value, sd } (mg/dL), or null if the filter isn't ready
+ */
+Predictor.prototype.predict = function (minutes) {
+	if (!this.isReady()) {
+		return null;
+	}
+
+	var h = minutes;
+	var variance =
+		this.p00 + 2 * h * this.p01 + h * h * this.p11 + (ACCELERATION_NOISE * h * h * h) / 3;
+
+	return {
+		minutes: minutes,
+		value: this.level + this.slope * h,
+		sd: Math.sqrt(Math.max(variance, 0))
+	};
+};
+
+/**
+ * Predictions for each of PREDICTION_HORIZONS, or an empty list if not ready
+ */
+Predictor.prototype.getPredictions = function () {
+	var predictions = [];
+	for (var i = 0; i < PREDICTION_HORIZONS.length; i++) {
+		var prediction = this.predict(PREDICTION_HORIZONS[i]);
+		if (prediction) {
+			predictions.push(prediction);
+		}
+	}
+	return predictions;
+};
+
+/**
+ * Predictions every TRAJECTORY_STEP_MINUTES up to TRAJECTORY_MINUTES after the
+ * latest reading, or an empty list if not ready
+ */
+Predictor.prototype.getTrajectory = function () {
+	var trajectory = [];
+	for (var minutes = TRAJECTORY_STEP_MINUTES; minutes <= TRAJECTORY_MINUTES; minutes += TRAJECTORY_STEP_MINUTES) {
+		var prediction = this.predict(minutes);
+		if (prediction) {
+			trajectory.push(prediction);
+		}
+	}
+	return trajectory;
+};
+
+module.exports = {
+	Predictor: Predictor,
+	PREDICTION_HORIZONS: PREDICTION_HORIZONS,
+	TRAJECTORY_MINUTES: TRAJECTORY_MINUTES
+};
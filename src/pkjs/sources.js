@@ -0,0 +1,296 @@
+/**
+ * T1000 CGM Watchface - Glucose data sources
+ *
+ * Each source handles login, incremental fetch and normalization for one backend
+ * and returns readings as { time, value, trend } numbers (ms, mg/dL, Dexcom trend index).
+ *
+ * Source interface:
+ *   isConfigured()          credentials are filled in
+ *   getCredentialKey()      identifies the account a session belongs to
+ *   needsLogin              whether the source uses sessions at all
+ *   hasValidSession()       session present and not due for a refresh
+ *   login()                 Promise, establishes a session
+ *   getSession() / restoreSession(session) / clearSession()
+ *   fetchReadings(window)   Promise of normalized readings, window = { minutes, maxCount }
+ */
+
+var http = require("./http");
+
+// Dexcom Share API endpoints
+var DEXCOM_URLS = {
+	us: "https://share1.dexcom.com",
+	international: "https://shareous1.dexcom.com"
+};
+
+// Dexcom application ID (same as official Dexcom app uses)
+var DEXCOM_APP_ID = "d89443d2-327c-4a6f-89e5-496bbb0317db";
+
+// Dexcom sessions are refreshed proactively well before the server expires them
+var SESSION_MAX_AGE_MS = 6 * 60 * 60 * 1000; // 6 hours
+
+// Trend direction mapping (Dexcom values, also used by Nightscout's "direction")
+var TREND_DIRECTIONS = {
+	None: 0,
+	DoubleUp: 1,
+	SingleUp: 2,
+	FortyFiveUp: 3,
+	Flat: 4,
+	FortyFiveDown: 5,
+	SingleDown: 6,
+	DoubleDown: 7,
+	"NOT COMPUTABLE": 0,
+	"RATE OUT OF RANGE": 0
+};
+
+/**
+ * Simple string hash (djb2) so a stored session can be tied to the
+ * credentials without keeping another copy of the password around
+ */
+function hashString(str) {
+	var hash = 5381;
+	for (var i = 0; i < str.length; i++) {
+		hash = ((hash << 5) + hash + str.charCodeAt(i)) | 0;
+	}
+	return (hash >>> 0).toString(16);
+}
+
+/**
+ * Map a trend name or number to the trend index used on the watch
+ */
+function normalizeTrend(trend) {
+	if (typeof trend === "number") {
+		return trend > 7 ? 0 : trend;
+	}
+	return TREND_DIRECTIONS[trend || "None"] || 0;
+}
+
+/**
+ * Parse Dexcom timestamp
+ * Format: "/Date(1234567890000)/"
+ */
+function parseDexcomTimestamp(dtString) {
+	var match = dtString.match(/Date\((\d+)\)/);
+	if (match) {
+		return parseInt(match[1], 10);
+	}
+	return null;
+}
+
+/**
+ * Normalize a raw Dexcom reading into { time, value, trend } numbers
+ * Returns null if the reading has no usable timestamp or value
+ */
+function normalizeDexcomReading(raw) {
+	if (!raw || !raw.WT || !raw.Value) {
+		return null;
+	}
+
+	var time = parseDexcomTimestamp(raw.WT);
+	if (!time) {
+		return null;
+	}
+
+	return { time: time, value: raw.Value, trend: normalizeTrend(raw.Trend) };
+}
+
+/**
+ * Normalize a Nightscout SGV entry into { time, value, trend } numbers
+ */
+function normalizeNightscoutEntry(entry) {
+	if (!entry || !entry.date || !entry.sgv) {
+		return null;
+	}
+	return { time: entry.date, value: entry.sgv, trend: normalizeTrend(entry.direction) };
+}
+
+/**
+ * Normalize a list of raw readings, dropping unusable ones
+ */
+function normalizeAll(raw, normalize) {
+	var list = Array.isArray(raw) ? raw : [];
+	var readings = [];
+	for (var i = 0; i < list.length; i++) {
+		var reading = normalize(list[i]);
+		if (reading) {
+			readings.push(reading);
+		}
+	}
+	return readings;
+}
+
+/**
+ * Dexcom Share source
+ * Reads credentials from the (live) settings object
+ */
+function DexcomShareSource(settings) {
+	this.settings = settings;
+	this.sessionId = null;
+	this.sessionCreatedAt = null;
+}
+
+DexcomShareSource.prototype.name = "dexcom";
+DexcomShareSource.prototype.needsLogin = true;
+
+DexcomShareSource.prototype.isConfigured = function () {
+	return !!(this.settings.accountName && this.settings.password);
+};
+
+/**
+ * Identify the account a session belongs to (server + username + password)
+ */
+DexcomShareSource.prototype.getCredentialKey = function () {
+	return (
+		"dexcom:" + this.settings.server + ":" + this.settings.accountName + ":" + hashString(this.settings.password)
+	);
+};
+
+/**
+ * Get the Dexcom Share base URL based on settings
+ */
+DexcomShareSource.prototype.getBaseUrl = function () {
+	return DEXCOM_URLS[this.settings.server] || DEXCOM_URLS.us;
+};
+
+DexcomShareSource.prototype.hasValidSession = function () {
+	if (!this.sessionId || !this.sessionCreatedAt) {
+		return false;
+	}
+	return Date.now() - this.sessionCreatedAt < SESSION_MAX_AGE_MS;
+};
+
+DexcomShareSource.prototype.getSession = function () {
+	return this.sessionId ? { id: this.sessionId, createdAt: this.sessionCreatedAt } : null;
+};
+
+DexcomShareSource.prototype.restoreSession = function (session) {
+	this.sessionId = session.id || null;
+	this.sessionCreatedAt = session.createdAt || null;
+};
+
+DexcomShareSource.prototype.clearSession = function () {
+	this.sessionId = null;
+	this.sessionCreatedAt = null;
+};
+
+/**
+ * Authenticate with Dexcom Share
+ */
+DexcomShareSource.prototype.login = function () {
+	var self = this;
+	var url = this.getBaseUrl() + "/ShareWebServices/Services/General/LoginPublisherAccountByName";
+
+	console.log("Logging in to Dexcom Share...");
+
+	return http
+		.httpRequest("POST", url, {
+			accountName: this.settings.accountName,
+			password: this.settings.password,
+			applicationId: DEXCOM_APP_ID
+		})
+		.then(function (response) {
+			self.sessionId = response;
+			self.sessionCreatedAt = Date.now();
+			console.log("Login successful, session: " + self.sessionId.substring(0, 8) + "...");
+			return self.sessionId;
+		});
+};
+
+/**
+ * Fetch glucose readings from Dexcom Share
+ */
+DexcomShareSource.prototype.fetchReadings = function (fetchWindow) {
+	if (!this.sessionId) {
+		return Promise.reject(new Error("Not logged in"));
+	}
+
+	var url =
+		this.getBaseUrl() +
+		"/ShareWebServices/Services/Publisher/ReadPublisherLatestGlucoseValues" +
+		"?sessionID=" +
+		encodeURIComponent(this.sessionId) +
+		"&minutes=" +
+		fetchWindow.minutes +
+		"&maxCount=" +
+		fetchWindow.maxCount;
+
+	console.log("Fetching glucose readings (minutes=" + fetchWindow.minutes + ", maxCount=" + fetchWindow.maxCount + ")...");
+
+	return http.httpRequest("POST", url, null).then(function (raw) {
+		return normalizeAll(raw, normalizeDexcomReading);
+	});
+};
+
+/**
+ * Nightscout-style REST source (GET /api/v1/entries.json)
+ * Authenticates each request with an access token, so there is no session
+ */
+function NightscoutSource(settings) {
+	this.settings = settings;
+}
+
+NightscoutSource.prototype.name = "nightscout";
+NightscoutSource.prototype.needsLogin = false;
+
+NightscoutSource.prototype.isConfigured = function () {
+	return !!this.settings.nightscoutUrl;
+};
+
+NightscoutSource.prototype.getCredentialKey = function () {
+	return "nightscout:" + this.settings.nightscoutUrl + ":" + hashString(this.settings.nightscoutToken);
+};
+
+NightscoutSource.prototype.hasValidSession = function () {
+	return true;
+};
+
+NightscoutSource.prototype.getSession = function () {
+	return null;
+};
+
+NightscoutSource.prototype.restoreSession = function () {};
+
+NightscoutSource.prototype.clearSession = function () {};
+
+NightscoutSource.prototype.login = function () {
+	return Promise.resolve();
+};
+
+/**
+ * Fetch SGV entries newer than the fetch window start
+ */
+NightscoutSource.prototype.fetchReadings = function (fetchWindow) {
+	var baseUrl = this.settings.nightscoutUrl.replace(/\/+$/, "");
+	var since = Date.now() - fetchWindow.minutes * 60000;
+	var url =
+		baseUrl +
+		"/api/v1/entries/sgv.json" +
+		"?count=" +
+		fetchWindow.maxCount +
+		"&find[date][$gt]=" +
+		since;
+	if (this.settings.nightscoutToken) {
+		url += "&token=" + encodeURIComponent(this.settings.nightscoutToken);
+	}
+
+	console.log("Fetching Nightscout entries (minutes=" + fetchWindow.minutes + ", count=" + fetchWindow.maxCount + ")...");
+
+	return http.httpRequest("GET", url, null).then(function (raw) {
+		return normalizeAll(raw, normalizeNightscoutEntry);
+	});
+};
+
+/**
+ * Create the data source selected in settings
+ */
+function createSource(settings) {
+	if (settings.source === "nightscout") {
+		return new NightscoutSource(settings);
+	}
+	return new DexcomShareSource(settings);
+}
+
+module.exports = {
+	createSource: createSource,
+	normalizeDexcomReading: normalizeDexcomReading,
+	hashString: hashString
+};
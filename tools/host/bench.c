@@ -0,0 +1,139 @@
+/**
+ * T1000 CGM Watchface - Host benchmarks
+ *
+ * Builds src/c/main.c against the stub SDK and times the hot paths on the watch:
+ * parsing the chart history and meal strings, handling a full data message, and
+ * drawing the chart. Reports ns/op and the drawing primitives issued per frame.
+ *
+ * Host timings are only useful relative to each other (the watch is a ~100MHz
+ * Cortex-M), but primitive counts carry over directly.
+ */
+
+// Compile the watchface into this translation unit so its static functions are reachable
+#define main t1000_main
+#include "../../src/c/main.c"
+#undef main
+
+// Representative payloads (24 readings over 2 hours, a full day's worth of meals)
+static const char *BENCH_HISTORY =
+    "182:0,178:5,171:10,165:15,160:20,152:25,147:30,140:35,"
+    "133:40,128:45,121:50,117:55,110:60,104:65,98:70,91:75,"
+    "88:80,84:85,80:90,77:95,72:100,69:105,66:110,64:115";
+static const char *BENCH_MEALS = "45:15,12:40,30:75,8:95,20:118,25:-10";
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Build the dictionary processReadings() sends (numbers go over the wire as int32)
+ */
+static void build_data_message(DictionaryIterator *iter, uint8_t *buffer, size_t capacity) {
+    host_dict_init(iter, buffer, capacity);
+    dict_write_int32(iter, KEY_CGM_TREND, TREND_UP_45);
+    dict_write_int32(iter, KEY_CGM_TIME_AGO, 2);
+    dict_write_cstring(iter, KEY_CGM_HISTORY, BENCH_HISTORY);
+    dict_write_int32(iter, KEY_CGM_ALERT, ALERT_NONE);
+    dict_write_int32(iter, KEY_LOW_THRESHOLD, 70);
+    dict_write_int32(iter, KEY_HIGH_THRESHOLD, 180);
+    dict_write_int32(iter, KEY_REVERSED, 0);
+    dict_write_int32(iter, KEY_UNIT, 0);
+    dict_write_int32(iter, KEY_NEEDS_SETUP, 0);
+    dict_write_int32(iter, KEY_SYNC_ERROR, 0);
+    dict_write_cstring(iter, KEY_MEAL_DATA, BENCH_MEALS);
+}
+
+static void report(const char *name, uint64_t elapsed_ns, int iterations) {
+    printf("%-28s %10.1f ns/op  (%d iterations)\n", name, (double)elapsed_ns / iterations, iterations);
+}
+
+static void report_primitives(const char *name, const GContext *ctx) {
+    printf("%-28s %4u primitives/frame:", name, host_gcontext_total(ctx));
+    for (int i = 0; i < HOST_PRIM_COUNT; i++) {
+        if (ctx->counts[i]) {
+            printf(" %s=%u", host_primitive_name(i), ctx->counts[i]);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    if (iterations <= 0) {
+        iterations = 1;
+    }
+
+    host_set_time(1700000000);
+    init();
+
+    // Parsing
+    uint64_t start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        parse_chart_history(s_account, BENCH_HISTORY);
+    }
+    report("parse_chart_history", now_ns() - start, iterations);
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        parse_meal_data(BENCH_MEALS);
+    }
+    report("parse_meal_data", now_ns() - start, iterations);
+
+    // Full message handling (parsing plus layer updates)
+    static uint8_t buffer[1024];
+    DictionaryIterator iter;
+    build_data_message(&iter, buffer, sizeof(buffer));
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        inbox_received_callback(&iter, NULL);
+    }
+    report("inbox_received_callback", now_ns() - start, iterations);
+
+    // One new reading every 5 minutes into the 24-hour statistics (retiring the expired one)
+    time_t reading_time = time(NULL);
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        reading_time += STATS_SLOT_SECONDS;
+        stats_add_reading(reading_time, 60 + i % 240);
+    }
+    report("stats_add_reading", now_ns() - start, iterations);
+
+    // Drawing (the message above left a full chart and meals in place)
+    GContext ctx;
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        host_gcontext_init(&ctx);
+        chart_layer_update_proc(s_chart_layer, &ctx);
+    }
+    report("chart_layer_update_proc", now_ns() - start, iterations);
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        host_gcontext_init(&ctx);
+        battery_layer_update_proc(s_battery_layer, &ctx);
+    }
+    report("battery_layer_update_proc", now_ns() - start, iterations);
+
+    printf("\n");
+    host_gcontext_init(&ctx);
+    chart_layer_update_proc(s_chart_layer, &ctx);
+    report_primitives("chart (24 points, 6 meals)", &ctx);
+
+    host_gcontext_init(&ctx);
+    battery_layer_update_proc(s_battery_layer, &ctx);
+    report_primitives("battery", &ctx);
+
+    host_gcontext_init(&ctx);
+    alert_layer_update_proc(s_alert_layer, &ctx);
+    report_primitives("alert", &ctx);
+
+    printf("\nheap high-water %u bytes (%s), %u free at that point\n",
+           (unsigned)s_heap_high_water, s_heap_high_water_at,
+           (unsigned)(heap_bytes_free() + heap_bytes_used() - s_heap_high_water));
+
+    deinit();
+    return 0;
+}
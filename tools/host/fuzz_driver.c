@@ -0,0 +1,168 @@
+/**
+ * T1000 CGM Watchface - Standalone fuzz driver
+ *
+ * Runs LLVMFuzzerTestOneInput without libFuzzer:
+ *
+ *   fuzz-inbox FILE|DIR...              replay inputs (corpus regression, AFL with @@)
+ *   fuzz-inbox -runs=N [-seed=S] DIR    replay, then N random mutations of the inputs
+ *
+ * The mutator is deliberately simple (bit flips, byte sets, interesting values,
+ * splices). Build with clang -fsanitize=fuzzer for coverage-guided fuzzing.
+ */
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#define MAX_INPUTS 1024
+#define MAX_INPUT_SIZE 4096
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+} Input;
+
+static Input s_inputs[MAX_INPUTS];
+static int s_input_count = 0;
+static uint64_t s_rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t next_random(void) {
+    // xorshift64*
+    s_rng ^= s_rng >> 12;
+    s_rng ^= s_rng << 25;
+    s_rng ^= s_rng >> 27;
+    return (uint32_t)((s_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static void add_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file || s_input_count >= MAX_INPUTS) {
+        if (file) {
+            fclose(file);
+        }
+        return;
+    }
+    uint8_t *data = malloc(MAX_INPUT_SIZE);
+    size_t size = fread(data, 1, MAX_INPUT_SIZE, file);
+    fclose(file);
+    s_inputs[s_input_count++] = (Input) { data, size };
+}
+
+static void add_path(const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        add_file(path);
+        return;
+    }
+    DIR *dir = opendir(path);
+    struct dirent *entry;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        char child[1024];
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        add_file(child);
+    }
+    closedir(dir);
+}
+
+static size_t mutate(uint8_t *data, size_t size) {
+    static const int32_t interesting[] = { 0, 1, -1, 127, 128, 255, 256, 32767, -32768, 65535, 0x7FFFFFFF, (int32_t)0x80000000 };
+    int mutations = 1 + next_random() % 8;
+
+    for (int m = 0; m < mutations && size > 0; m++) {
+        size_t pos = next_random() % size;
+        switch (next_random() % 6) {
+            case 0:
+                data[pos] ^= (uint8_t)(1 << (next_random() % 8));
+                break;
+            case 1:
+                data[pos] = (uint8_t)next_random();
+                break;
+            case 2: {
+                int32_t value = interesting[next_random() % (sizeof(interesting) / sizeof(interesting[0]))];
+                size_t width = 1 << (next_random() % 3);
+                if (pos + width <= size) {
+                    memcpy(data + pos, &value, width);
+                }
+                break;
+            }
+            case 3:
+                // ASCII digits and separators exercise the string parsers
+                data[pos] = (uint8_t)"0123456789:,-\0x"[next_random() % 15];
+                break;
+            case 4:
+                // Truncate
+                size = pos + 1;
+                break;
+            case 5: {
+                // Splice a chunk from another input
+                Input *other = &s_inputs[next_random() % s_input_count];
+                if (other->size > 0) {
+                    size_t from = next_random() % other->size;
+                    size_t len = 1 + next_random() % 32;
+                    if (from + len > other->size) {
+                        len = other->size - from;
+                    }
+                    if (pos + len > MAX_INPUT_SIZE) {
+                        len = MAX_INPUT_SIZE - pos;
+                    }
+                    memcpy(data + pos, other->data + from, len);
+                    if (pos + len > size) {
+                        size = pos + len;
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return size;
+}
+
+int main(int argc, char **argv) {
+    long runs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = atol(argv[i] + 6);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            s_rng = strtoull(argv[i] + 6, NULL, 10) * 0x9E3779B97F4A7C15ull + 1;
+        } else {
+            add_path(argv[i]);
+        }
+    }
+
+    if (s_input_count == 0) {
+        fprintf(stderr, "usage: %s [-runs=N] [-seed=S] FILE|DIR...\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 0; i < s_input_count; i++) {
+        LLVMFuzzerTestOneInput(s_inputs[i].data, s_inputs[i].size);
+    }
+    printf("Replayed %d inputs\n", s_input_count);
+
+    if (runs > 0) {
+        uint8_t *scratch = malloc(MAX_INPUT_SIZE);
+        for (long r = 0; r < runs; r++) {
+            Input *base = &s_inputs[next_random() % s_input_count];
+            memcpy(scratch, base->data, base->size);
+            size_t size = mutate(scratch, base->size);
+            LLVMFuzzerTestOneInput(scratch, size);
+        }
+        free(scratch);
+        printf("Ran %ld mutated inputs\n", runs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * T1000 CGM Watchface - AppMessage inbox fuzz target
+ *
+ * Decodes the input as a Pebble dictionary (see make-corpus.js for the format),
+ * delivers it to inbox_received_callback and then redraws every layer and fires
+ * pending timers, so parsed values also flow through the drawing code.
+ *
+ * Tuple framing is validated the way the firmware does before delivery, but keys,
+ * types, lengths and contents are left as the fuzzer chose them. State carries over
+ * between inputs, as it does on the watch.
+ *
+ * Builds as a libFuzzer target (LLVMFuzzerTestOneInput), or with fuzz_driver.c for
+ * AFL and plain corpus replay.
+ */
+
+#define main t1000_main
+#include "../../src/c/main.c"
+#undef main
+
+// Inbox size main.c passes to app_message_open()
+#define FUZZ_INBOX_SIZE INBOX_SIZE
+
+static bool s_fuzz_initialized = false;
+
+static void fuzz_draw(Layer *layer) {
+    if (layer && layer->update_proc) {
+        GContext ctx;
+        host_gcontext_init(&ctx);
+        layer->update_proc(layer, &ctx);
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (!s_fuzz_initialized) {
+        host_set_time(1700000000);
+        init();
+        s_fuzz_initialized = true;
+    }
+
+    if (size < 1) {
+        return 0;
+    }
+
+    // Rebuild the dictionary in a separate buffer so reads past a tuple's end are caught
+    static uint8_t buffer[FUZZ_INBOX_SIZE];
+    DictionaryIterator iter;
+    host_dict_init(&iter, buffer, sizeof(buffer));
+
+    uint8_t count = data[0];
+    size_t offset = 1;
+    for (uint8_t i = 0; i < count; i++) {
+        if (offset + sizeof(Tuple) > size) {
+            break;
+        }
+        Tuple header;
+        memcpy(&header, data + offset, sizeof(Tuple));
+        offset += sizeof(Tuple);
+        if (offset + header.length > size) {
+            break;
+        }
+        if (host_dict_write_raw(&iter, header.key, header.type, data + offset, header.length) != DICT_OK) {
+            break;
+        }
+        offset += header.length;
+    }
+
+    // Copy into an exactly-sized allocation so the sanitizer sees the true end of the message
+    uint8_t *message = malloc(iter.size ? iter.size : 1);
+    memcpy(message, buffer, iter.size);
+    DictionaryIterator delivered;
+    host_dict_init(&delivered, message, iter.size);
+    delivered.size = iter.size;
+
+    inbox_received_callback(&delivered, NULL);
+    free(message);
+
+    // Exercise everything that reads the parsed state
+    Layer *layers[] = {
+        s_chart_layer, s_battery_layer, s_sync_layer, s_alert_layer, s_loading_layer
+    };
+    for (size_t i = 0; i < ARRAY_LENGTH(layers); i++) {
+        fuzz_draw(layers[i]);
+    }
+    tick_handler(NULL, MINUTE_UNIT);
+    host_run_timers(1000);
+
+    // Switch accounts (if following several) so the next input lands on another one
+    accel_tap_handler(ACCEL_AXIS_Y, 1);
+
+    return 0;
+}
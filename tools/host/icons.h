@@ -0,0 +1,530 @@
+/**
+ * T1000 CGM Watchface - Trend icons for the host rasterizer
+ *
+ * Generated by make-icons.js from resources/images; do not edit.
+ * '#' white, 'o' black, '.' transparent.
+ */
+
+#pragma once
+
+typedef struct {
+    uint32_t resource_id;
+    int16_t width;
+    int16_t height;
+    const char *rows[30];
+} HostIcon;
+
+static const HostIcon HOST_ICONS[] = {
+    { RESOURCE_ID_IMAGE_TREND_NONE_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooo######oooooooooooo",
+        "oooooooooo##########oooooooooo",
+        "ooooooooo############ooooooooo",
+        "oooooooo#####oooo#####oooooooo",
+        "oooooooo####oooooo####oooooooo",
+        "oooooooo###ooooooo####oooooooo",
+        "oooooooo###ooooooo####oooooooo",
+        "oooooooo###ooooooo####oooooooo",
+        "oooooooooooooooooo####oooooooo",
+        "ooooooooooooooooo####ooooooooo",
+        "oooooooooooooooo####oooooooooo",
+        "ooooooooooooooo####ooooooooooo",
+        "oooooooooooooo####oooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "ooooooooooooo####ooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOUBLE_UP_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooo#oooooooooooo#oooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "oooooo#####oooooooo#####oooooo",
+        "ooooo#######oooooo#######ooooo",
+        "oooo#########oooo#########oooo",
+        "ooo###########oo###########ooo",
+        "ooo###########oo###########ooo",
+        "ooo###o###o###oo###o###o###ooo",
+        "ooo##oo###oo##oo##oo###oo##ooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_UP_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooo#ooooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "oooooooooooo#####ooooooooooooo",
+        "ooooooooooo#######oooooooooooo",
+        "oooooooooo#########ooooooooooo",
+        "ooooooooo###########oooooooooo",
+        "oooooooo#############ooooooooo",
+        "ooooooo#####o###o#####oooooooo",
+        "ooooooo####oo###oo####oooooooo",
+        "oooooooo##ooo###ooo##ooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_UP_45_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "ooooooooooo#############oooooo",
+        "ooooooooooo#############oooooo",
+        "ooooooooooo#############oooooo",
+        "oooooooooooooooooo######oooooo",
+        "ooooooooooooooooo#######oooooo",
+        "oooooooooooooooo########oooooo",
+        "ooooooooooooooo#####o###oooooo",
+        "oooooooooooooo#####oo###oooooo",
+        "ooooooooooooo#####ooo###oooooo",
+        "oooooooooooo#####oooo###oooooo",
+        "ooooooooooo#####ooooo###oooooo",
+        "oooooooooo#####oooooo###oooooo",
+        "ooooooooo#####ooooooo###oooooo",
+        "oooooooo#####ooooooooooooooooo",
+        "ooooooo#####oooooooooooooooooo",
+        "oooooo#####ooooooooooooooooooo",
+        "oooooo####oooooooooooooooooooo",
+        "ooooooo##ooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_FLAT_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "ooooooooooooooooo##ooooooooooo",
+        "oooooooooooooooo####oooooooooo",
+        "oooooooooooooooo#####ooooooooo",
+        "ooooooooooooooooo#####oooooooo",
+        "oooooooooooooooooo#####ooooooo",
+        "ooooooooooooooooooo#####oooooo",
+        "oooo#####################ooooo",
+        "oooo######################oooo",
+        "oooo#####################ooooo",
+        "ooooooooooooooooooo#####oooooo",
+        "oooooooooooooooooo#####ooooooo",
+        "ooooooooooooooooo#####oooooooo",
+        "oooooooooooooooo#####ooooooooo",
+        "oooooooooooooooo####oooooooooo",
+        "ooooooooooooooooo##ooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOWN_45_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "ooooooo##ooooooooooooooooooooo",
+        "oooooo####oooooooooooooooooooo",
+        "oooooo#####ooooooooooooooooooo",
+        "ooooooo#####oooooooooooooooooo",
+        "oooooooo#####ooooooooooooooooo",
+        "ooooooooo#####ooooooo###oooooo",
+        "oooooooooo#####oooooo###oooooo",
+        "ooooooooooo#####ooooo###oooooo",
+        "oooooooooooo#####oooo###oooooo",
+        "ooooooooooooo#####ooo###oooooo",
+        "oooooooooooooo#####oo###oooooo",
+        "ooooooooooooooo#####o###oooooo",
+        "oooooooooooooooo########oooooo",
+        "ooooooooooooooooo#######oooooo",
+        "oooooooooooooooooo######oooooo",
+        "ooooooooooo#############oooooo",
+        "ooooooooooo#############oooooo",
+        "ooooooooooo#############oooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOWN_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "oooooooo##ooo###ooo##ooooooooo",
+        "ooooooo####oo###oo####oooooooo",
+        "ooooooo#####o###o#####oooooooo",
+        "oooooooo#############ooooooooo",
+        "ooooooooo###########oooooooooo",
+        "oooooooooo#########ooooooooooo",
+        "ooooooooooo#######oooooooooooo",
+        "oooooooooooo#####ooooooooooooo",
+        "ooooooooooooo###oooooooooooooo",
+        "oooooooooooooo#ooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOUBLE_DOWN_WHITE, 30, 30, {
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "ooo##oo###oo##oo##oo###oo##ooo",
+        "ooo###o###o###oo###o###o###ooo",
+        "ooo###########oo###########ooo",
+        "ooo###########oo###########ooo",
+        "oooo#########oooo#########oooo",
+        "ooooo#######oooooo#######ooooo",
+        "oooooo#####oooooooo#####oooooo",
+        "ooooooo###oooooooooo###ooooooo",
+        "oooooooo#oooooooooooo#oooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+        "oooooooooooooooooooooooooooooo",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_NONE_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "############oooooo############",
+        "##########oooooooooo##########",
+        "#########oooooooooooo#########",
+        "########ooooo####ooooo########",
+        "########oooo######oooo########",
+        "########ooo#######oooo########",
+        "########ooo#######oooo########",
+        "########ooo#######oooo########",
+        "##################oooo########",
+        "#################oooo#########",
+        "################oooo##########",
+        "###############oooo###########",
+        "##############oooo############",
+        "#############oooo#############",
+        "#############oooo#############",
+        "#############oooo#############",
+        "#############oooo#############",
+        "##############################",
+        "##############################",
+        "#############oooo#############",
+        "#############oooo#############",
+        "#############oooo#############",
+        "#############oooo#############",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOUBLE_UP_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "########o############o########",
+        "#######ooo##########ooo#######",
+        "######ooooo########ooooo######",
+        "#####ooooooo######ooooooo#####",
+        "####ooooooooo####ooooooooo####",
+        "###ooooooooooo##ooooooooooo###",
+        "###ooooooooooo##ooooooooooo###",
+        "###ooo#ooo#ooo##ooo#ooo#ooo###",
+        "###oo##ooo##oo##oo##ooo##oo###",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_UP_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############o###############",
+        "#############ooo##############",
+        "############ooooo#############",
+        "###########ooooooo############",
+        "##########ooooooooo###########",
+        "#########ooooooooooo##########",
+        "########ooooooooooooo#########",
+        "#######ooooo#ooo#ooooo########",
+        "#######oooo##ooo##oooo########",
+        "########oo###ooo###oo#########",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_UP_45_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "###########ooooooooooooo######",
+        "###########ooooooooooooo######",
+        "###########ooooooooooooo######",
+        "##################oooooo######",
+        "#################ooooooo######",
+        "################oooooooo######",
+        "###############ooooo#ooo######",
+        "##############ooooo##ooo######",
+        "#############ooooo###ooo######",
+        "############ooooo####ooo######",
+        "###########ooooo#####ooo######",
+        "##########ooooo######ooo######",
+        "#########ooooo#######ooo######",
+        "########ooooo#################",
+        "#######ooooo##################",
+        "######ooooo###################",
+        "######oooo####################",
+        "#######oo#####################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_FLAT_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "#################oo###########",
+        "################oooo##########",
+        "################ooooo#########",
+        "#################ooooo########",
+        "##################ooooo#######",
+        "###################ooooo######",
+        "####ooooooooooooooooooooo#####",
+        "####oooooooooooooooooooooo####",
+        "####ooooooooooooooooooooo#####",
+        "###################ooooo######",
+        "##################ooooo#######",
+        "#################ooooo########",
+        "################ooooo#########",
+        "################oooo##########",
+        "#################oo###########",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOWN_45_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "#######oo#####################",
+        "######oooo####################",
+        "######ooooo###################",
+        "#######ooooo##################",
+        "########ooooo#################",
+        "#########ooooo#######ooo######",
+        "##########ooooo######ooo######",
+        "###########ooooo#####ooo######",
+        "############ooooo####ooo######",
+        "#############ooooo###ooo######",
+        "##############ooooo##ooo######",
+        "###############ooooo#ooo######",
+        "################oooooooo######",
+        "#################ooooooo######",
+        "##################oooooo######",
+        "###########ooooooooooooo######",
+        "###########ooooooooooooo######",
+        "###########ooooooooooooo######",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOWN_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "#############ooo##############",
+        "########oo###ooo###oo#########",
+        "#######oooo##ooo##oooo########",
+        "#######ooooo#ooo#ooooo########",
+        "########ooooooooooooo#########",
+        "#########ooooooooooo##########",
+        "##########ooooooooo###########",
+        "###########ooooooo############",
+        "############ooooo#############",
+        "#############ooo##############",
+        "##############o###############",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+    { RESOURCE_ID_IMAGE_TREND_DOUBLE_DOWN_BLACK, 30, 30, {
+        "##############################",
+        "##############################",
+        "##############################",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "#######ooo##########ooo#######",
+        "###oo##ooo##oo##oo##ooo##oo###",
+        "###ooo#ooo#ooo##ooo#ooo#ooo###",
+        "###ooooooooooo##ooooooooooo###",
+        "###ooooooooooo##ooooooooooo###",
+        "####ooooooooo####ooooooooo####",
+        "#####ooooooo######ooooooo#####",
+        "######ooooo########ooooo######",
+        "#######ooo##########ooo#######",
+        "########o############o########",
+        "##############################",
+        "##############################",
+        "##############################",
+        "##############################",
+    } },
+};
@@ -0,0 +1,180 @@
+#!/usr/bin/env node
+/**
+ * T1000 CGM Watchface - Fuzz seed corpus generator
+ *
+ * Replays traces through src/pkjs/index.js (tools/replay.js) and serializes a
+ * varied subset of the AppMessages processReadings() and sendError() send to the
+ * watch, in the Pebble dictionary wire format read by fuzz_inbox.c, plus the
+ * worst-case messages main.c sizes its inbox for (INBOX_SIZE):
+ *
+ *   u8 tuple count, then per tuple: u32 key, u8 type, u16 length, value (little endian)
+ *
+ * Usage: node tools/host/make-corpus.js [output dir]
+ */
+
+var childProcess = require("child_process");
+var fs = require("fs");
+var os = require("os");
+var path = require("path");
+
+var REPLAY = path.join(__dirname, "..", "replay.js");
+var OUTPUT_DIR = process.argv[2] || path.join(__dirname, "corpus", "inbox");
+
+// Seeds kept per distinct message shape
+var SEEDS_PER_SHAPE = 2;
+
+// Tuple types (must match TupleType in pebble.h)
+var TUPLE_BYTE_ARRAY = 0;
+var TUPLE_CSTRING = 1;
+var TUPLE_INT = 3;
+
+var SCENARIOS = [
+	{
+		name: "meals and alerts",
+		args: [
+			"--hours", "72",
+			"--meals", "45:30,12:95,60:400,25:720,30:1100",
+			"--settings", JSON.stringify({ saltieApiToken: "replay", vibeEnabled: true, vibeLowSoonEnabled: true, showBands: true })
+		]
+	},
+	{
+		name: "reversed, mmol/L, stats view",
+		args: ["--hours", "6", "--settings", JSON.stringify({ reversed: true, unit: "mmol", defaultView: "stats" })]
+	},
+	{
+		name: "flaky network",
+		args: ["--hours", "6", "--error-rate", "0.4", "--source", "nightscout"]
+	},
+	{
+		name: "followers",
+		args: [
+			"--hours", "6",
+			"--error-rate", "0.1",
+			"--settings", JSON.stringify({ follower1AccountName: "sam", follower1Password: "replay", follower1Label: "Sam" })
+		]
+	}
+];
+
+/**
+ * Serialize a PebbleKit JS message the way the phone sends it
+ * (numbers as int32, arrays as byte arrays)
+ */
+function encodeMessage(message) {
+	var keys = Object.keys(message);
+	var parts = [Buffer.from([keys.length])];
+
+	keys.forEach(function (key) {
+		var value = message[key];
+		var data;
+		var type;
+		if (typeof value === "string") {
+			data = Buffer.concat([Buffer.from(value, "utf8"), Buffer.from([0])]);
+			type = TUPLE_CSTRING;
+		} else if (Array.isArray(value)) {
+			data = Buffer.from(value);
+			type = TUPLE_BYTE_ARRAY;
+		} else {
+			data = Buffer.alloc(4);
+			data.writeInt32LE(value | 0, 0);
+			type = TUPLE_INT;
+		}
+		var header = Buffer.alloc(7);
+		header.writeUInt32LE(parseInt(key, 10), 0);
+		header.writeUInt8(type, 4);
+		header.writeUInt16LE(data.length, 5);
+		parts.push(header, data);
+	});
+
+	return Buffer.concat(parts);
+}
+
+/**
+ * Data message with every field at its longest, as budgeted by INBOX_SIZE in main.c
+ * (618 bytes with 24 chart points, 690 with 32)
+ */
+function worstCaseMessage(chartPoints) {
+	var history = [];
+	for (var i = 0; i < chartPoints; i++) {
+		history.push("400:" + (1440 - i * 5));
+	}
+	var prediction = [];
+	var meals = [];
+	for (var j = 0; j < 10; j++) {
+		if (j < 6) {
+			prediction.push("399:-" + (10 + j * 4));
+		}
+		meals.push("150:-" + (11 + j));
+	}
+	var bands = [];
+	for (var k = 0; k < 96; k++) {
+		bands.push(200 - (k % 4) * 40);
+	}
+
+	var message = {};
+	[2, 3, 9, 11, 7, 8, 10, 19, 13, 20, 16, 17].forEach(function (key) {
+		message[key] = key === 16 ? 1 : 3; // Ints: trend, time ago, settings, account 1 of 3
+	});
+	message[4] = history.join(",");
+	message[14] = prediction.join(",");
+	message[12] = meals.join(",");
+	message[15] = bands;
+	message[18] = "Follower1";
+	return message;
+}
+
+/**
+ * LOW / HIGH if the latest reading in a history string is outside the sensor range
+ */
+function rangeOf(history) {
+	var latest = history ? parseInt(history, 10) : 0;
+	return latest && latest < 40 ? "LOW" : latest > 400 ? "HIGH" : "";
+}
+
+/**
+ * Coarse message shape: which keys are present plus the fields that change code paths
+ */
+function shapeOf(message) {
+	return [
+		Object.keys(message).sort().join(","),
+		message[5] || 0, // Alert type
+		message[12] ? (message[12].indexOf("-") >= 0 ? "future-meal" : "meal") : "no-meal",
+		rangeOf(message[4]),
+		message[10] || 0, // Reversed
+		message[11] || 0, // Sync error
+		message[15] ? message[15].length : 0, // Percentile bands (96 bytes, or 1 to clear)
+		message[16] || 0 // Account
+	].join("|");
+}
+
+var dumpFile = path.join(os.tmpdir(), "t1000-corpus-" + process.pid + ".jsonl");
+var perShape = {};
+var seeds = [];
+
+SCENARIOS.forEach(function (scenario) {
+	childProcess.execFileSync("node", [REPLAY, "--dump-messages", dumpFile].concat(scenario.args));
+	var lines = fs.readFileSync(dumpFile, "utf8").split("\n").filter(Boolean);
+	lines.forEach(function (line) {
+		var message = JSON.parse(line).message;
+		var shape = shapeOf(message);
+		perShape[shape] = (perShape[shape] || 0) + 1;
+		if (perShape[shape] <= SEEDS_PER_SHAPE) {
+			seeds.push(encodeMessage(message));
+		}
+	});
+	console.log(scenario.name + ": " + lines.length + " messages");
+});
+fs.unlinkSync(dumpFile);
+[24, 32].forEach(function (chartPoints) {
+	seeds.push(encodeMessage(worstCaseMessage(chartPoints)));
+});
+
+fs.mkdirSync(OUTPUT_DIR, { recursive: true });
+fs.readdirSync(OUTPUT_DIR).forEach(function (file) {
+	if (/^seed-\d+\.bin$/.test(file)) {
+		fs.unlinkSync(path.join(OUTPUT_DIR, file));
+	}
+});
+seeds.forEach(function (seed, i) {
+	fs.writeFileSync(path.join(OUTPUT_DIR, "seed-" + ("00" + i).slice(-3) + ".bin"), seed);
+});
+console.log("Wrote " + seeds.length + " seeds to " + path.relative(process.cwd(), OUTPUT_DIR));
@@ -0,0 +1,180 @@
+#!/usr/bin/env node
+/**
+ * T1000 CGM Watchface - Trend icon converter for the host rasterizer
+ *
+ * Decodes the trend arrow PNGs listed in package.json and writes icons.h, one
+ * string row per pixel row: '#' white, 'o' black, '.' transparent.
+ *
+ * Usage: node tools/host/make-icons.js
+ */
+
+var fs = require("fs");
+var path = require("path");
+var zlib = require("zlib");
+
+var ROOT = path.join(__dirname, "..", "..");
+var OUTPUT = path.join(__dirname, "icons.h");
+
+/**
+ * Decode a non-interlaced PNG (grayscale, RGB, palette or with alpha) into RGBA
+ */
+function decodePng(file) {
+	var data = fs.readFileSync(file);
+	var offset = 8;
+	var header = null;
+	var palette = null;
+	var transparency = null;
+	var idat = [];
+
+	while (offset < data.length) {
+		var length = data.readUInt32BE(offset);
+		var type = data.toString("ascii", offset + 4, offset + 8);
+		var chunk = data.subarray(offset + 8, offset + 8 + length);
+		if (type === "IHDR") {
+			header = {
+				width: chunk.readUInt32BE(0),
+				height: chunk.readUInt32BE(4),
+				depth: chunk[8],
+				colorType: chunk[9],
+				interlace: chunk[12]
+			};
+		} else if (type === "PLTE") {
+			palette = chunk;
+		} else if (type === "tRNS") {
+			transparency = chunk;
+		} else if (type === "IDAT") {
+			idat.push(chunk);
+		}
+		offset += 12 + length;
+	}
+
+	if (header.interlace) {
+		throw new Error(file + ": interlaced PNGs are not supported");
+	}
+
+	var channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }[header.colorType];
+	var bitsPerPixel = channels * header.depth;
+	var stride = Math.ceil((header.width * bitsPerPixel) / 8);
+	var bpp = Math.max(1, bitsPerPixel >> 3);
+	var raw = zlib.inflateSync(Buffer.concat(idat));
+	var pixels = Buffer.alloc(stride * header.height);
+	var previous = Buffer.alloc(stride);
+
+	// Undo the per-row filters
+	for (var y = 0; y < header.height; y++) {
+		var filter = raw[y * (stride + 1)];
+		var row = raw.subarray(y * (stride + 1) + 1, (y + 1) * (stride + 1));
+		var out = pixels.subarray(y * stride, (y + 1) * stride);
+		for (var x = 0; x < stride; x++) {
+			var a = x >= bpp ? out[x - bpp] : 0;
+			var b = previous[x];
+			var c = x >= bpp ? previous[x - bpp] : 0;
+			var predictor = 0;
+			if (filter === 1) {
+				predictor = a;
+			} else if (filter === 2) {
+				predictor = b;
+			} else if (filter === 3) {
+				predictor = (a + b) >> 1;
+			} else if (filter === 4) {
+				var p = a + b - c;
+				var pa = Math.abs(p - a);
+				var pb = Math.abs(p - b);
+				var pc = Math.abs(p - c);
+				predictor = pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+			}
+			out[x] = (row[x] + predictor) & 0xff;
+		}
+		previous = out;
+	}
+
+	function sample(x, y, channel) {
+		var bit = (x * channels + channel) * header.depth;
+		var byte = pixels[y * stride + (bit >> 3)];
+		if (header.depth >= 8) {
+			return byte;
+		}
+		var shift = 8 - header.depth - (bit & 7);
+		return (byte >> shift) & ((1 << header.depth) - 1);
+	}
+
+	var maxValue = (1 << Math.min(header.depth, 8)) - 1;
+	var rgba = [];
+	for (var py = 0; py < header.height; py++) {
+		for (var px = 0; px < header.width; px++) {
+			var r, g, bl, alpha = 255;
+			if (header.colorType === 3) {
+				var index = sample(px, py, 0);
+				r = palette[index * 3];
+				g = palette[index * 3 + 1];
+				bl = palette[index * 3 + 2];
+				alpha = transparency && index < transparency.length ? transparency[index] : 255;
+			} else if (header.colorType === 0 || header.colorType === 4) {
+				r = g = bl = Math.round((sample(px, py, 0) * 255) / maxValue);
+				if (header.colorType === 4) {
+					alpha = sample(px, py, 1);
+				}
+			} else {
+				r = sample(px, py, 0);
+				g = sample(px, py, 1);
+				bl = sample(px, py, 2);
+				if (header.colorType === 6) {
+					alpha = sample(px, py, 3);
+				}
+			}
+			rgba.push([r, g, bl, alpha]);
+		}
+	}
+
+	return { width: header.width, height: header.height, pixels: rgba };
+}
+
+var appinfo = JSON.parse(fs.readFileSync(path.join(ROOT, "package.json"), "utf8"));
+var media = appinfo.pebble.resources.media.filter(function (entry) {
+	return /^IMAGE_TREND_/.test(entry.name);
+});
+
+var lines = [
+	"/**",
+	" * T1000 CGM Watchface - Trend icons for the host rasterizer",
+	" *",
+	" * Generated by make-icons.js from resources/images; do not edit.",
+	" * '#' white, 'o' black, '.' transparent.",
+	" */",
+	"",
+	"#pragma once",
+	"",
+	"typedef struct {",
+	"    uint32_t resource_id;",
+	"    int16_t width;",
+	"    int16_t height;",
+	"    const char *rows[30];",
+	"} HostIcon;",
+	"",
+	"static const HostIcon HOST_ICONS[] = {"
+];
+
+media.forEach(function (entry) {
+	var image = decodePng(path.join(ROOT, "resources", entry.file));
+	if (image.height > 30) {
+		throw new Error(entry.file + ": icons taller than 30px are not supported");
+	}
+	// main.c names the white icons with a _WHITE suffix
+	var id = /_BLACK$/.test(entry.name) ? entry.name : entry.name + "_WHITE";
+	lines.push("    { RESOURCE_ID_" + id + ", " + image.width + ", " + image.height + ", {");
+	for (var y = 0; y < image.height; y++) {
+		var row = "";
+		for (var x = 0; x < image.width; x++) {
+			var p = image.pixels[y * image.width + x];
+			var opaque = p[3] >= 128;
+			var bright = p[0] + p[1] + p[2] >= 384;
+			row += !opaque ? "." : bright ? "#" : "o";
+		}
+		lines.push('        "' + row + '",');
+	}
+	lines.push("    } },");
+});
+
+lines.push("};", "");
+fs.writeFileSync(OUTPUT, lines.join("\n"));
+console.log("Wrote " + media.length + " icons to " + path.relative(process.cwd(), OUTPUT));
@@ -0,0 +1,565 @@
+/**
+ * T1000 CGM Watchface - Host stub of the Pebble SDK
+ *
+ * Just enough of pebble.h to compile src/c/main.c natively on Linux for
+ * benchmarking and fuzzing. Layers, timers and AppMessage are simple in-memory
+ * stand-ins, and GContext records the drawing primitives issued by update procs.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+// Platform
+// ---------------------------------------------------------------------------
+
+// Target platform, picked with -DPBL_PLATFORM_<NAME> like the SDK's per-platform builds
+// (aplite by default, basalt when only PBL_COLOR is given)
+#if !defined(PBL_PLATFORM_APLITE) && !defined(PBL_PLATFORM_BASALT) && !defined(PBL_PLATFORM_CHALK) && \
+    !defined(PBL_PLATFORM_DIORITE) && !defined(PBL_PLATFORM_EMERY)
+#ifdef PBL_COLOR
+#define PBL_PLATFORM_BASALT
+#else
+#define PBL_PLATFORM_APLITE
+#endif
+#endif
+
+#if defined(PBL_PLATFORM_BASALT) || defined(PBL_PLATFORM_CHALK) || defined(PBL_PLATFORM_EMERY)
+#ifndef PBL_COLOR
+#define PBL_COLOR
+#endif
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_false)
+#else
+#define PBL_BW
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_true)
+#endif
+
+#if defined(PBL_PLATFORM_CHALK)
+#define PBL_ROUND
+#define PBL_DISPLAY_WIDTH 180
+#define PBL_DISPLAY_HEIGHT 180
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_false)
+#else
+#define PBL_RECT
+#if defined(PBL_PLATFORM_EMERY)
+#define PBL_DISPLAY_WIDTH 200
+#define PBL_DISPLAY_HEIGHT 228
+#else
+#define PBL_DISPLAY_WIDTH 144
+#define PBL_DISPLAY_HEIGHT 168
+#endif
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_true)
+#endif
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef enum {
+    APP_LOG_LEVEL_ERROR = 1,
+    APP_LOG_LEVEL_WARNING = 50,
+    APP_LOG_LEVEL_INFO = 100,
+    APP_LOG_LEVEL_DEBUG = 200,
+    APP_LOG_LEVEL_DEBUG_VERBOSE = 255,
+} AppLogLevel;
+
+// Logging is compiled out on the host (the benchmarks would only measure printf)
+#define APP_LOG(level, fmt, ...) ((void)(level))
+
+bool clock_is_24h_style(void);
+
+// Wall clock used by the app (settable on the host so runs are deterministic)
+time_t host_time(time_t *tloc);
+void host_set_time(time_t now);
+#define time(tloc) host_time(tloc)
+
+size_t heap_bytes_used(void);
+size_t heap_bytes_free(void);
+
+// Allocations charged to the app heap (24 KB monochrome, 64 KB color)
+void *host_heap_alloc(size_t size);
+void host_heap_free(void *ptr);
+
+// ---------------------------------------------------------------------------
+// Geometry and colors
+// ---------------------------------------------------------------------------
+
+typedef struct GPoint {
+    int16_t x;
+    int16_t y;
+} GPoint;
+
+typedef struct GSize {
+    int16_t w;
+    int16_t h;
+} GSize;
+
+typedef struct GRect {
+    GPoint origin;
+    GSize size;
+} GRect;
+
+#define GPoint(x, y) ((GPoint){ (x), (y) })
+#define GSize(w, h) ((GSize){ (w), (h) })
+#define GRect(x, y, w, h) ((GRect){ { (x), (y) }, { (w), (h) } })
+#define GRectZero GRect(0, 0, 0, 0)
+
+typedef union GColor8 {
+    uint8_t argb;
+} GColor8;
+
+typedef GColor8 GColor;
+
+#define GColorFromARGB(a) ((GColor8){ .argb = (a) })
+#define GColorClear   GColorFromARGB(0x00)
+#define GColorBlack   GColorFromARGB(0xC0)
+#define GColorWhite   GColorFromARGB(0xFF)
+#define GColorRed     GColorFromARGB(0xF0)
+#define GColorOrange  GColorFromARGB(0xF4)
+#define GColorGreen   GColorFromARGB(0xCC)
+#define GColorDarkGray  GColorFromARGB(0xD5)
+#define GColorLightGray GColorFromARGB(0xEA)
+#define GColorEq(a, b) ((a).argb == (b).argb)
+
+typedef enum {
+    GCornerNone = 0,
+    GCornerTopLeft = 1 << 0,
+    GCornerTopRight = 1 << 1,
+    GCornerBottomLeft = 1 << 2,
+    GCornerBottomRight = 1 << 3,
+    GCornersAll = 0xF,
+} GCornerMask;
+
+typedef enum {
+    GCompOpAssign,
+    GCompOpAssignInverted,
+    GCompOpOr,
+    GCompOpAnd,
+    GCompOpClear,
+    GCompOpSet,
+} GCompOp;
+
+typedef enum {
+    GAlignCenter,
+    GAlignTopLeft,
+    GAlignTopRight,
+    GAlignTop,
+    GAlignLeft,
+    GAlignBottom,
+    GAlignRight,
+    GAlignBottomRight,
+    GAlignBottomLeft,
+} GAlign;
+
+typedef enum {
+    GTextAlignmentLeft,
+    GTextAlignmentCenter,
+    GTextAlignmentRight,
+} GTextAlignment;
+
+typedef enum {
+    GTextOverflowModeWordWrap,
+    GTextOverflowModeTrailingEllipsis,
+    GTextOverflowModeFill,
+} GTextOverflowMode;
+
+typedef enum {
+    GOvalScaleModeFitCircle,
+    GOvalScaleModeFillCircle,
+} GOvalScaleMode;
+
+#define TRIG_MAX_ANGLE 0x10000
+#define DEG_TO_TRIGANGLE(angle) (((angle) * TRIG_MAX_ANGLE) / 360)
+
+// ---------------------------------------------------------------------------
+// Fonts and resources
+// ---------------------------------------------------------------------------
+
+typedef struct HostFont {
+    const char *key;
+    int height;  // Line height in pixels
+    int scale;   // Pixels per dot of the built-in 5x7 glyphs
+} HostFont;
+
+typedef const HostFont *GFont;
+
+#define FONT_KEY_GOTHIC_14          "RESOURCE_ID_GOTHIC_14"
+#define FONT_KEY_GOTHIC_14_BOLD     "RESOURCE_ID_GOTHIC_14_BOLD"
+#define FONT_KEY_GOTHIC_18_BOLD     "RESOURCE_ID_GOTHIC_18_BOLD"
+#define FONT_KEY_GOTHIC_24_BOLD     "RESOURCE_ID_GOTHIC_24_BOLD"
+#define FONT_KEY_GOTHIC_28_BOLD     "RESOURCE_ID_GOTHIC_28_BOLD"
+#define FONT_KEY_BITHAM_42_BOLD     "RESOURCE_ID_BITHAM_42_BOLD"
+
+GFont fonts_get_system_font(const char *font_key);
+
+enum {
+    RESOURCE_ID_IMAGE_TREND_NONE_WHITE = 1,
+    RESOURCE_ID_IMAGE_TREND_DOUBLE_UP_WHITE,
+    RESOURCE_ID_IMAGE_TREND_UP_WHITE,
+    RESOURCE_ID_IMAGE_TREND_UP_45_WHITE,
+    RESOURCE_ID_IMAGE_TREND_FLAT_WHITE,
+    RESOURCE_ID_IMAGE_TREND_DOWN_45_WHITE,
+    RESOURCE_ID_IMAGE_TREND_DOWN_WHITE,
+    RESOURCE_ID_IMAGE_TREND_DOUBLE_DOWN_WHITE,
+    RESOURCE_ID_IMAGE_TREND_NONE_BLACK,
+    RESOURCE_ID_IMAGE_TREND_DOUBLE_UP_BLACK,
+    RESOURCE_ID_IMAGE_TREND_UP_BLACK,
+    RESOURCE_ID_IMAGE_TREND_UP_45_BLACK,
+    RESOURCE_ID_IMAGE_TREND_FLAT_BLACK,
+    RESOURCE_ID_IMAGE_TREND_DOWN_45_BLACK,
+    RESOURCE_ID_IMAGE_TREND_DOWN_BLACK,
+    RESOURCE_ID_IMAGE_TREND_DOUBLE_DOWN_BLACK,
+};
+
+typedef struct GBitmap {
+    uint32_t resource_id;
+} GBitmap;
+
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id);
+void gbitmap_destroy(GBitmap *bitmap);
+
+// ---------------------------------------------------------------------------
+// Graphics context (records primitives, and rasterizes when given a framebuffer)
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    HOST_PRIM_FILL_RECT,
+    HOST_PRIM_FILL_CIRCLE,
+    HOST_PRIM_DRAW_CIRCLE,
+    HOST_PRIM_DRAW_PIXEL,
+    HOST_PRIM_DRAW_LINE,
+    HOST_PRIM_DRAW_ROUND_RECT,
+    HOST_PRIM_DRAW_ARC,
+    HOST_PRIM_GPATH_FILLED,
+    HOST_PRIM_DRAW_TEXT,
+    HOST_PRIM_TEXT_LAYOUT,
+    HOST_PRIM_COUNT
+} HostPrimitive;
+
+typedef struct GContext {
+    GColor fill_color;
+    GColor stroke_color;
+    GColor text_color;
+    uint8_t stroke_width;
+    uint32_t counts[HOST_PRIM_COUNT];
+
+    // Optional framebuffer (one GColor8 per pixel); drawing is offset and clipped to the current layer
+    GColor8 *framebuffer;
+    GSize fb_size;
+    GPoint offset;
+    GRect clip;
+} GContext;
+
+void host_gcontext_init(GContext *ctx);
+void host_gcontext_attach(GContext *ctx, GColor8 *framebuffer, GSize size);
+uint32_t host_gcontext_total(const GContext *ctx);
+const char *host_primitive_name(HostPrimitive primitive);
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t width);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_fill_circle(GContext *ctx, GPoint center, uint16_t radius);
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_pixel(GContext *ctx, GPoint point);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_draw_round_rect(GContext *ctx, GRect rect, uint16_t radius);
+void graphics_draw_arc(GContext *ctx, GRect rect, GOvalScaleMode scale_mode, int32_t angle_start, int32_t angle_end);
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+                        GTextOverflowMode overflow_mode, GTextAlignment alignment, void *text_attributes);
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+                                            GTextOverflowMode overflow_mode, GTextAlignment alignment);
+
+typedef struct GPathInfo {
+    uint32_t num_points;
+    GPoint *points;
+} GPathInfo;
+
+typedef struct GPath {
+    uint32_t num_points;
+    GPoint *points;
+    GPoint offset;
+} GPath;
+
+GPath *gpath_create(const GPathInfo *init);
+void gpath_destroy(GPath *path);
+void gpath_draw_filled(GContext *ctx, GPath *path);
+
+// ---------------------------------------------------------------------------
+// Layers and windows
+// ---------------------------------------------------------------------------
+
+typedef struct Layer Layer;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+typedef enum {
+    HOST_LAYER_PLAIN,
+    HOST_LAYER_TEXT,
+    HOST_LAYER_BITMAP,
+} HostLayerKind;
+
+struct Layer {
+    HostLayerKind kind;
+    GRect frame;
+    bool hidden;
+    LayerUpdateProc update_proc;
+    Layer *parent;
+    Layer *first_child;
+    Layer *next_sibling;
+    uint32_t dirty_count;
+};
+
+Layer *layer_create(GRect frame);
+void layer_destroy(Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+void layer_set_hidden(Layer *layer, bool hidden);
+bool layer_get_hidden(const Layer *layer);
+void layer_set_frame(Layer *layer, GRect frame);
+GRect layer_get_frame(const Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+
+typedef struct TextLayer {
+    Layer layer;
+    const char *text;
+    GFont font;
+    GColor text_color;
+    GColor background_color;
+    GTextAlignment alignment;
+} TextLayer;
+
+TextLayer *text_layer_create(GRect frame);
+void text_layer_destroy(TextLayer *text_layer);
+Layer *text_layer_get_layer(TextLayer *text_layer);
+void text_layer_set_text(TextLayer *text_layer, const char *text);
+void text_layer_set_font(TextLayer *text_layer, GFont font);
+void text_layer_set_text_color(TextLayer *text_layer, GColor color);
+void text_layer_set_background_color(TextLayer *text_layer, GColor color);
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment alignment);
+
+typedef struct BitmapLayer {
+    Layer layer;
+    const GBitmap *bitmap;
+    GCompOp compositing_mode;
+    GAlign alignment;
+} BitmapLayer;
+
+BitmapLayer *bitmap_layer_create(GRect frame);
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer);
+Layer *bitmap_layer_get_layer(BitmapLayer *bitmap_layer);
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap);
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode);
+void bitmap_layer_set_alignment(BitmapLayer *bitmap_layer, GAlign alignment);
+
+typedef struct Window Window;
+typedef void (*WindowHandler)(Window *window);
+
+typedef struct WindowHandlers {
+    WindowHandler load;
+    WindowHandler appear;
+    WindowHandler disappear;
+    WindowHandler unload;
+} WindowHandlers;
+
+struct Window {
+    Layer root_layer;
+    WindowHandlers handlers;
+    GColor background_color;
+};
+
+Window *window_create(void);
+void window_destroy(Window *window);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_set_background_color(Window *window, GColor color);
+Layer *window_get_root_layer(const Window *window);
+void window_stack_push(Window *window, bool animated);
+
+// Host screen size (defaults to Aplite/Basalt 144x168)
+void host_set_screen_size(int16_t w, int16_t h);
+GSize host_get_screen_size(void);
+
+// Draw a window and its visible layers, as the compositor would on a redraw
+void host_render_window(Window *window, GContext *ctx);
+
+// ---------------------------------------------------------------------------
+// Timers, services and vibes
+// ---------------------------------------------------------------------------
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *data);
+void app_timer_cancel(AppTimer *timer);
+bool app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms);
+
+// Fire every pending timer due within `elapsed_ms` of host time (in due order)
+void host_run_timers(uint32_t elapsed_ms);
+int host_pending_timers(void);
+
+typedef enum {
+    SECOND_UNIT = 1 << 0,
+    MINUTE_UNIT = 1 << 1,
+    HOUR_UNIT = 1 << 2,
+    DAY_UNIT = 1 << 3,
+    MONTH_UNIT = 1 << 4,
+    YEAR_UNIT = 1 << 5,
+} TimeUnits;
+
+typedef void (*TickHandler)(struct tm *tick_time, TimeUnits units_changed);
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler);
+void tick_timer_service_unsubscribe(void);
+
+typedef struct BatteryChargeState {
+    uint8_t charge_percent;
+    bool is_charging;
+    bool is_plugged;
+} BatteryChargeState;
+
+typedef void (*BatteryStateHandler)(BatteryChargeState charge);
+void battery_state_service_subscribe(BatteryStateHandler handler);
+void battery_state_service_unsubscribe(void);
+BatteryChargeState battery_state_service_peek(void);
+
+typedef enum {
+    ACCEL_AXIS_X = 0,
+    ACCEL_AXIS_Y = 1,
+    ACCEL_AXIS_Z = 2,
+} AccelAxisType;
+
+typedef void (*AccelTapHandler)(AccelAxisType axis, int32_t direction);
+void accel_tap_service_subscribe(AccelTapHandler handler);
+void accel_tap_service_unsubscribe(void);
+
+typedef struct VibePattern {
+    const uint32_t *durations;
+    uint32_t num_segments;
+} VibePattern;
+
+void vibes_enqueue_custom_pattern(VibePattern pattern);
+void vibes_short_pulse(void);
+void vibes_long_pulse(void);
+void vibes_double_pulse(void);
+
+// Number of vibration patterns enqueued so far
+uint32_t host_vibe_count(void);
+
+// ---------------------------------------------------------------------------
+// Persistent storage (in memory, lost when the process exits)
+// ---------------------------------------------------------------------------
+
+typedef int32_t status_t;
+
+#define S_SUCCESS                 0
+#define E_INVALID_ARGUMENT        (-4)
+#define E_OUT_OF_STORAGE          (-6)
+#define E_DOES_NOT_EXIST          (-9)
+
+#define PERSIST_DATA_MAX_LENGTH   256
+
+bool persist_exists(const uint32_t key);
+int persist_get_size(const uint32_t key);
+int32_t persist_read_int(const uint32_t key);
+status_t persist_write_int(const uint32_t key, const int32_t value);
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size);
+int persist_write_data(const uint32_t key, const void *data, const size_t size);
+status_t persist_delete(const uint32_t key);
+
+// Forget everything written so far
+void host_persist_clear(void);
+
+// ---------------------------------------------------------------------------
+// Dictionaries and AppMessage
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    TUPLE_BYTE_ARRAY = 0,
+    TUPLE_CSTRING = 1,
+    TUPLE_UINT = 2,
+    TUPLE_INT = 3,
+} TupleType;
+
+typedef union TupleValue {
+    uint8_t data[0];
+    char cstring[0];
+    uint8_t uint8;
+    uint16_t uint16;
+    uint32_t uint32;
+    int8_t int8;
+    int16_t int16;
+    int32_t int32;
+} TupleValue;
+
+typedef struct __attribute__((__packed__)) Tuple {
+    uint32_t key;
+    TupleType type:8;
+    uint16_t length;
+    TupleValue value[];
+} Tuple;
+
+typedef struct DictionaryIterator {
+    uint8_t *buffer;
+    size_t capacity;
+    size_t size;
+    Tuple *cursor;
+} DictionaryIterator;
+
+typedef enum {
+    DICT_OK = 0,
+    DICT_NOT_ENOUGH_STORAGE = 1 << 1,
+    DICT_INVALID_ARGS = 1 << 2,
+} DictionaryResult;
+
+Tuple *dict_find(const DictionaryIterator *iter, const uint32_t key);
+DictionaryResult dict_write_uint8(DictionaryIterator *iter, const uint32_t key, const uint8_t value);
+DictionaryResult dict_write_int32(DictionaryIterator *iter, const uint32_t key, const int32_t value);
+DictionaryResult dict_write_cstring(DictionaryIterator *iter, const uint32_t key, const char *cstring);
+DictionaryResult dict_write_data(DictionaryIterator *iter, const uint32_t key, const uint8_t *data, const uint16_t size);
+
+// Start writing a dictionary into a caller-provided buffer
+void host_dict_init(DictionaryIterator *iter, uint8_t *buffer, size_t capacity);
+// Append a tuple with an explicit type and raw value (used to build malformed inputs)
+DictionaryResult host_dict_write_raw(DictionaryIterator *iter, uint32_t key, TupleType type,
+                                     const uint8_t *data, uint16_t length);
+
+typedef enum {
+    APP_MSG_OK = 0,
+    APP_MSG_SEND_TIMEOUT = 1 << 1,
+    APP_MSG_SEND_REJECTED = 1 << 2,
+    APP_MSG_NOT_CONNECTED = 1 << 3,
+    APP_MSG_APP_NOT_RUNNING = 1 << 4,
+    APP_MSG_INVALID_ARGS = 1 << 5,
+    APP_MSG_BUSY = 1 << 6,
+    APP_MSG_BUFFER_OVERFLOW = 1 << 7,
+    APP_MSG_OUT_OF_MEMORY = 1 << 12,
+    APP_MSG_CLOSED = 1 << 13,
+    APP_MSG_INTERNAL_ERROR = 1 << 14,
+} AppMessageResult;
+
+typedef void (*AppMessageInboxReceived)(DictionaryIterator *iterator, void *context);
+typedef void (*AppMessageInboxDropped)(AppMessageResult reason, void *context);
+typedef void (*AppMessageOutboxSent)(DictionaryIterator *iterator, void *context);
+typedef void (*AppMessageOutboxFailed)(DictionaryIterator *iterator, AppMessageResult reason, void *context);
+
+AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound);
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback);
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback);
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback);
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback);
+AppMessageResult app_message_outbox_begin(DictionaryIterator **iterator);
+AppMessageResult app_message_outbox_send(void);
+
+// Number of outbox messages sent so far
+uint32_t host_outbox_count(void);
+
+void app_event_loop(void);
@@ -0,0 +1,548 @@
+/**
+ * T1000 CGM Watchface - Host stub of the Pebble SDK
+ *
+ * In-memory implementations of the pebble.h declarations. Fonts, bitmaps and
+ * drawing live in raster.c.
+ */
+
+#include "pebble.h"
+
+// ---------------------------------------------------------------------------
+// Platform
+// ---------------------------------------------------------------------------
+
+static time_t s_host_now = 0;
+
+time_t host_time(time_t *tloc) {
+    time_t now = s_host_now ? s_host_now : (time)(NULL);
+    if (tloc) {
+        *tloc = now;
+    }
+    return now;
+}
+
+void host_set_time(time_t now) {
+    s_host_now = now;
+}
+
+bool clock_is_24h_style(void) {
+    return true;
+}
+
+// App heap: SDK objects are allocated through host_heap_alloc so heap_bytes_used()
+// reflects what the app holds (sizes are the stub's, not the firmware's)
+#ifdef PBL_COLOR
+#define HOST_HEAP_SIZE (64 * 1024)
+#else
+#define HOST_HEAP_SIZE (24 * 1024)
+#endif
+#define HOST_HEAP_BLOCK_OVERHEAD 8
+
+static size_t s_heap_used = 0;
+
+void *host_heap_alloc(size_t size) {
+    size_t *block = malloc(sizeof(size_t) + size);
+    block[0] = size;
+    s_heap_used += size + HOST_HEAP_BLOCK_OVERHEAD;
+    return block + 1;
+}
+
+void host_heap_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    size_t *block = (size_t *)ptr - 1;
+    s_heap_used -= block[0] + HOST_HEAP_BLOCK_OVERHEAD;
+    free(block);
+}
+
+size_t heap_bytes_used(void) {
+    return s_heap_used;
+}
+
+size_t heap_bytes_free(void) {
+    return s_heap_used < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - s_heap_used : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Layers and windows
+// ---------------------------------------------------------------------------
+
+static GSize s_screen_size = { PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT };
+
+void host_set_screen_size(int16_t w, int16_t h) {
+    s_screen_size = GSize(w, h);
+}
+
+GSize host_get_screen_size(void) {
+    return s_screen_size;
+}
+
+static void layer_init(Layer *layer, GRect frame) {
+    memset(layer, 0, sizeof(*layer));
+    layer->frame = frame;
+}
+
+Layer *layer_create(GRect frame) {
+    Layer *layer = host_heap_alloc(sizeof(Layer));
+    layer_init(layer, frame);
+    return layer;
+}
+
+void layer_destroy(Layer *layer) {
+    host_heap_free(layer);
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+    layer->update_proc = update_proc;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+    child->parent = parent;
+    child->next_sibling = NULL;
+    Layer **link = &parent->first_child;
+    while (*link) {
+        link = &(*link)->next_sibling;
+    }
+    *link = child;
+}
+
+void layer_mark_dirty(Layer *layer) {
+    layer->dirty_count++;
+}
+
+void layer_set_hidden(Layer *layer, bool hidden) {
+    layer->hidden = hidden;
+}
+
+bool layer_get_hidden(const Layer *layer) {
+    return layer->hidden;
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+    layer->frame = frame;
+}
+
+GRect layer_get_frame(const Layer *layer) {
+    return layer->frame;
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+    return GRect(0, 0, layer->frame.size.w, layer->frame.size.h);
+}
+
+TextLayer *text_layer_create(GRect frame) {
+    TextLayer *text_layer = host_heap_alloc(sizeof(TextLayer));
+    memset(text_layer, 0, sizeof(*text_layer));
+    layer_init(&text_layer->layer, frame);
+    text_layer->layer.kind = HOST_LAYER_TEXT;
+    text_layer->font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
+    text_layer->text_color = GColorBlack;
+    text_layer->background_color = GColorWhite;
+    return text_layer;
+}
+
+void text_layer_destroy(TextLayer *text_layer) {
+    host_heap_free(text_layer);
+}
+
+Layer *text_layer_get_layer(TextLayer *text_layer) {
+    return &text_layer->layer;
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+    text_layer->text = text;
+    layer_mark_dirty(&text_layer->layer);
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+    text_layer->font = font;
+}
+
+void text_layer_set_text_color(TextLayer *text_layer, GColor color) {
+    text_layer->text_color = color;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+    text_layer->background_color = color;
+}
+
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment alignment) {
+    text_layer->alignment = alignment;
+}
+
+BitmapLayer *bitmap_layer_create(GRect frame) {
+    BitmapLayer *bitmap_layer = host_heap_alloc(sizeof(BitmapLayer));
+    memset(bitmap_layer, 0, sizeof(*bitmap_layer));
+    layer_init(&bitmap_layer->layer, frame);
+    bitmap_layer->layer.kind = HOST_LAYER_BITMAP;
+    return bitmap_layer;
+}
+
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer) {
+    host_heap_free(bitmap_layer);
+}
+
+Layer *bitmap_layer_get_layer(BitmapLayer *bitmap_layer) {
+    return &bitmap_layer->layer;
+}
+
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap) {
+    bitmap_layer->bitmap = bitmap;
+}
+
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode) {
+    bitmap_layer->compositing_mode = mode;
+}
+
+void bitmap_layer_set_alignment(BitmapLayer *bitmap_layer, GAlign alignment) {
+    bitmap_layer->alignment = alignment;
+}
+
+Window *window_create(void) {
+    Window *window = host_heap_alloc(sizeof(Window));
+    memset(window, 0, sizeof(*window));
+    layer_init(&window->root_layer, GRect(0, 0, s_screen_size.w, s_screen_size.h));
+    window->background_color = GColorWhite;
+    return window;
+}
+
+void window_destroy(Window *window) {
+    if (window->handlers.unload) {
+        window->handlers.unload(window);
+    }
+    host_heap_free(window);
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+    window->handlers = handlers;
+}
+
+void window_set_background_color(Window *window, GColor color) {
+    window->background_color = color;
+}
+
+Layer *window_get_root_layer(const Window *window) {
+    return (Layer *)&window->root_layer;
+}
+
+void window_stack_push(Window *window, bool animated) {
+    if (window->handlers.load) {
+        window->handlers.load(window);
+    }
+    if (window->handlers.appear) {
+        window->handlers.appear(window);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Timers, services and vibes
+// ---------------------------------------------------------------------------
+
+#define HOST_MAX_TIMERS 32
+
+struct AppTimer {
+    bool active;
+    uint64_t due_ms;
+    AppTimerCallback callback;
+    void *data;
+};
+
+static AppTimer s_timers[HOST_MAX_TIMERS];
+static uint64_t s_timer_clock_ms = 0;
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *data) {
+    for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+        if (!s_timers[i].active) {
+            s_timers[i] = (AppTimer) {
+                .active = true,
+                .due_ms = s_timer_clock_ms + timeout_ms,
+                .callback = callback,
+                .data = data
+            };
+            return &s_timers[i];
+        }
+    }
+    return NULL;
+}
+
+void app_timer_cancel(AppTimer *timer) {
+    if (timer) {
+        timer->active = false;
+    }
+}
+
+bool app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms) {
+    if (!timer || !timer->active) {
+        return false;
+    }
+    timer->due_ms = s_timer_clock_ms + new_timeout_ms;
+    return true;
+}
+
+void host_run_timers(uint32_t elapsed_ms) {
+    uint64_t end_ms = s_timer_clock_ms + elapsed_ms;
+
+    for (;;) {
+        AppTimer *next = NULL;
+        for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+            if (s_timers[i].active && s_timers[i].due_ms <= end_ms &&
+                (!next || s_timers[i].due_ms < next->due_ms)) {
+                next = &s_timers[i];
+            }
+        }
+        if (!next) {
+            break;
+        }
+
+        // Timers are one-shot: free the slot before the callback so it can re-register
+        s_timer_clock_ms = next->due_ms;
+        next->active = false;
+        next->callback(next->data);
+    }
+
+    s_timer_clock_ms = end_ms;
+}
+
+int host_pending_timers(void) {
+    int count = 0;
+    for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+        count += s_timers[i].active;
+    }
+    return count;
+}
+
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) {
+}
+
+void tick_timer_service_unsubscribe(void) {
+}
+
+void battery_state_service_subscribe(BatteryStateHandler handler) {
+}
+
+void battery_state_service_unsubscribe(void) {
+}
+
+BatteryChargeState battery_state_service_peek(void) {
+    return (BatteryChargeState) { .charge_percent = 80, .is_charging = false, .is_plugged = false };
+}
+
+void accel_tap_service_subscribe(AccelTapHandler handler) {
+}
+
+void accel_tap_service_unsubscribe(void) {
+}
+
+static uint32_t s_vibe_count = 0;
+
+void vibes_enqueue_custom_pattern(VibePattern pattern) {
+    s_vibe_count++;
+}
+
+void vibes_short_pulse(void) {
+    s_vibe_count++;
+}
+
+void vibes_long_pulse(void) {
+    s_vibe_count++;
+}
+
+void vibes_double_pulse(void) {
+    s_vibe_count++;
+}
+
+uint32_t host_vibe_count(void) {
+    return s_vibe_count;
+}
+
+// ---------------------------------------------------------------------------
+// Persistent storage
+// ---------------------------------------------------------------------------
+
+#define HOST_PERSIST_SLOTS 32
+
+typedef struct {
+    bool used;
+    uint32_t key;
+    size_t size;
+    uint8_t data[PERSIST_DATA_MAX_LENGTH];
+} HostPersistEntry;
+
+static HostPersistEntry s_persist[HOST_PERSIST_SLOTS];
+
+static HostPersistEntry *persist_find(uint32_t key) {
+    for (int i = 0; i < HOST_PERSIST_SLOTS; i++) {
+        if (s_persist[i].used && s_persist[i].key == key) {
+            return &s_persist[i];
+        }
+    }
+    return NULL;
+}
+
+bool persist_exists(const uint32_t key) {
+    return persist_find(key) != NULL;
+}
+
+int persist_get_size(const uint32_t key) {
+    HostPersistEntry *entry = persist_find(key);
+    return entry ? (int)entry->size : E_DOES_NOT_EXIST;
+}
+
+int32_t persist_read_int(const uint32_t key) {
+    int32_t value = 0;
+    persist_read_data(key, &value, sizeof(value));
+    return value;
+}
+
+status_t persist_write_int(const uint32_t key, const int32_t value) {
+    int written = persist_write_data(key, &value, sizeof(value));
+    return written < 0 ? written : S_SUCCESS;
+}
+
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size) {
+    HostPersistEntry *entry = persist_find(key);
+    if (!entry) {
+        return E_DOES_NOT_EXIST;
+    }
+    size_t size = entry->size < buffer_size ? entry->size : buffer_size;
+    memcpy(buffer, entry->data, size);
+    return (int)size;
+}
+
+int persist_write_data(const uint32_t key, const void *data, const size_t size) {
+    if (!data || size > PERSIST_DATA_MAX_LENGTH) {
+        return E_INVALID_ARGUMENT;
+    }
+    HostPersistEntry *entry = persist_find(key);
+    for (int i = 0; !entry && i < HOST_PERSIST_SLOTS; i++) {
+        if (!s_persist[i].used) {
+            entry = &s_persist[i];
+        }
+    }
+    if (!entry) {
+        return E_OUT_OF_STORAGE;
+    }
+    entry->used = true;
+    entry->key = key;
+    entry->size = size;
+    memcpy(entry->data, data, size);
+    return (int)size;
+}
+
+status_t persist_delete(const uint32_t key) {
+    HostPersistEntry *entry = persist_find(key);
+    if (!entry) {
+        return E_DOES_NOT_EXIST;
+    }
+    entry->used = false;
+    return S_SUCCESS;
+}
+
+void host_persist_clear(void) {
+    memset(s_persist, 0, sizeof(s_persist));
+}
+
+// ---------------------------------------------------------------------------
+// Dictionaries
+// ---------------------------------------------------------------------------
+
+void host_dict_init(DictionaryIterator *iter, uint8_t *buffer, size_t capacity) {
+    iter->buffer = buffer;
+    iter->capacity = capacity;
+    iter->size = 0;
+    iter->cursor = (Tuple *)buffer;
+}
+
+DictionaryResult host_dict_write_raw(DictionaryIterator *iter, uint32_t key, TupleType type,
+                                     const uint8_t *data, uint16_t length) {
+    if (iter->size + sizeof(Tuple) + length > iter->capacity) {
+        return DICT_NOT_ENOUGH_STORAGE;
+    }
+    Tuple *tuple = (Tuple *)(iter->buffer + iter->size);
+    tuple->key = key;
+    tuple->type = type;
+    tuple->length = length;
+    if (length) {
+        memcpy(tuple->value->data, data, length);
+    }
+    iter->size += sizeof(Tuple) + length;
+    return DICT_OK;
+}
+
+Tuple *dict_find(const DictionaryIterator *iter, const uint32_t key) {
+    size_t offset = 0;
+    while (offset + sizeof(Tuple) <= iter->size) {
+        Tuple *tuple = (Tuple *)(iter->buffer + offset);
+        if (offset + sizeof(Tuple) + tuple->length > iter->size) {
+            break;
+        }
+        if (tuple->key == key) {
+            return tuple;
+        }
+        offset += sizeof(Tuple) + tuple->length;
+    }
+    return NULL;
+}
+
+DictionaryResult dict_write_uint8(DictionaryIterator *iter, const uint32_t key, const uint8_t value) {
+    return host_dict_write_raw(iter, key, TUPLE_UINT, &value, sizeof(value));
+}
+
+DictionaryResult dict_write_int32(DictionaryIterator *iter, const uint32_t key, const int32_t value) {
+    return host_dict_write_raw(iter, key, TUPLE_INT, (const uint8_t *)&value, sizeof(value));
+}
+
+DictionaryResult dict_write_cstring(DictionaryIterator *iter, const uint32_t key, const char *cstring) {
+    return host_dict_write_raw(iter, key, TUPLE_CSTRING, (const uint8_t *)cstring, (uint16_t)(strlen(cstring) + 1));
+}
+
+DictionaryResult dict_write_data(DictionaryIterator *iter, const uint32_t key, const uint8_t *data, const uint16_t size) {
+    return host_dict_write_raw(iter, key, TUPLE_BYTE_ARRAY, data, size);
+}
+
+// ---------------------------------------------------------------------------
+// AppMessage
+// ---------------------------------------------------------------------------
+
+static uint8_t s_outbox_buffer[256];
+static DictionaryIterator s_outbox_iter;
+static uint32_t s_outbox_count = 0;
+
+AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound) {
+    return APP_MSG_OK;
+}
+
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback) {
+    return NULL;
+}
+
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback) {
+    return NULL;
+}
+
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback) {
+    return NULL;
+}
+
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback) {
+    return NULL;
+}
+
+AppMessageResult app_message_outbox_begin(DictionaryIterator **iterator) {
+    host_dict_init(&s_outbox_iter, s_outbox_buffer, sizeof(s_outbox_buffer));
+    *iterator = &s_outbox_iter;
+    return APP_MSG_OK;
+}
+
+AppMessageResult app_message_outbox_send(void) {
+    s_outbox_count++;
+    return APP_MSG_OK;
+}
+
+uint32_t host_outbox_count(void) {
+    return s_outbox_count;
+}
+
+void app_event_loop(void) {
+}
@@ -0,0 +1,611 @@
+/**
+ * T1000 CGM Watchface - Host rasterizer for the stub Pebble SDK
+ *
+ * Software implementations of the drawing calls main.c makes. Every call is
+ * counted in the GContext; pixels are only written when a framebuffer is attached
+ * (host_gcontext_attach), so the benchmarks pay for counting alone.
+ *
+ * Output approximates the firmware rather than matching it pixel for pixel:
+ * text uses a scaled 5x7 bitmap font, and shapes use simple integer rules.
+ * That is enough for golden-image comparisons of the app's own layout.
+ */
+
+#include <math.h>
+
+#include "pebble.h"
+#include "icons.h"
+
+// ---------------------------------------------------------------------------
+// Fonts
+// ---------------------------------------------------------------------------
+
+static const HostFont s_fonts[] = {
+    { FONT_KEY_GOTHIC_14, 14, 1 },
+    { FONT_KEY_GOTHIC_14_BOLD, 14, 1 },
+    { FONT_KEY_GOTHIC_18_BOLD, 18, 1 },  // Gothic 18 digits are ~8px wide; 2x glyphs overrun the stats columns
+    { FONT_KEY_GOTHIC_24_BOLD, 24, 2 },
+    { FONT_KEY_GOTHIC_28_BOLD, 28, 2 },
+    { FONT_KEY_BITHAM_42_BOLD, 42, 4 },
+};
+
+// Classic 5x7 glyphs for ASCII 0x20-0x7E, one byte per column, bit 0 at the top
+static const uint8_t s_glyphs[][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 },
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 }, { 0x00, 0x1C, 0x22, 0x41, 0x00 },
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+    { 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x00, 0x60, 0x60, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x00, 0x14, 0x00, 0x00 },
+    { 0x00, 0x40, 0x34, 0x00, 0x00 }, { 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 }, { 0x3E, 0x41, 0x5D, 0x59, 0x4E },
+    { 0x7C, 0x12, 0x11, 0x12, 0x7C }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+    { 0x3E, 0x41, 0x41, 0x51, 0x73 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+    { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 },
+    { 0x26, 0x49, 0x49, 0x49, 0x32 }, { 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, { 0x63, 0x14, 0x08, 0x14, 0x63 },
+    { 0x03, 0x04, 0x78, 0x04, 0x03 }, { 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F }, { 0x04, 0x02, 0x01, 0x02, 0x04 },
+    { 0x40, 0x40, 0x40, 0x40, 0x40 }, { 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 },
+    { 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 }, { 0x38, 0x44, 0x44, 0x28, 0x7F },
+    { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x40, 0x3D, 0x00 },
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 }, { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 },
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, { 0xFC, 0x18, 0x24, 0x24, 0x18 },
+    { 0x18, 0x24, 0x24, 0x18, 0xFC }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 },
+    { 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C },
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C }, { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C },
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, { 0x00, 0x00, 0x77, 0x00, 0x00 },
+    { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x02, 0x01, 0x02, 0x04, 0x02 },
+};
+
+GFont fonts_get_system_font(const char *font_key) {
+    for (size_t i = 0; i < ARRAY_LENGTH(s_fonts); i++) {
+        if (strcmp(s_fonts[i].key, font_key) == 0) {
+            return &s_fonts[i];
+        }
+    }
+    return &s_fonts[0];
+}
+
+static int glyph_advance(GFont font) {
+    return 6 * font->scale;
+}
+
+// Width of one line of text (up to a newline or the end)
+static int line_width(const char *text, GFont font) {
+    int chars = 0;
+    while (text[chars] && text[chars] != '\n') {
+        chars++;
+    }
+    return chars ? chars * glyph_advance(font) - font->scale : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Bitmaps
+// ---------------------------------------------------------------------------
+
+static const HostIcon *find_icon(uint32_t resource_id) {
+    for (size_t i = 0; i < ARRAY_LENGTH(HOST_ICONS); i++) {
+        if (HOST_ICONS[i].resource_id == resource_id) {
+            return &HOST_ICONS[i];
+        }
+    }
+    return NULL;
+}
+
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id) {
+    // Charge the heap for the pixel data the firmware would load (1 bit or 1 byte per pixel)
+    const HostIcon *icon = find_icon(resource_id);
+    size_t pixels = 0;
+    if (icon) {
+#ifdef PBL_COLOR
+        pixels = (size_t)icon->width * icon->height;
+#else
+        pixels = (size_t)((icon->width + 31) / 32 * 4) * icon->height;
+#endif
+    }
+    GBitmap *bitmap = host_heap_alloc(sizeof(GBitmap) + pixels);
+    bitmap->resource_id = resource_id;
+    return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+    host_heap_free(bitmap);
+}
+
+// ---------------------------------------------------------------------------
+// Pixels
+// ---------------------------------------------------------------------------
+
+static const char *s_primitive_names[HOST_PRIM_COUNT] = {
+    "fill_rect",
+    "fill_circle",
+    "draw_circle",
+    "draw_pixel",
+    "draw_line",
+    "draw_round_rect",
+    "draw_arc",
+    "gpath_filled",
+    "draw_text",
+    "text_layout",
+};
+
+void host_gcontext_init(GContext *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->fill_color = GColorBlack;
+    ctx->stroke_color = GColorWhite;
+    ctx->text_color = GColorWhite;
+    ctx->stroke_width = 1;
+}
+
+void host_gcontext_attach(GContext *ctx, GColor8 *framebuffer, GSize size) {
+    ctx->framebuffer = framebuffer;
+    ctx->fb_size = size;
+    ctx->offset = GPoint(0, 0);
+    ctx->clip = GRect(0, 0, size.w, size.h);
+}
+
+uint32_t host_gcontext_total(const GContext *ctx) {
+    uint32_t total = 0;
+    // Text layout queries don't touch the framebuffer
+    for (int i = 0; i < HOST_PRIM_TEXT_LAYOUT; i++) {
+        total += ctx->counts[i];
+    }
+    return total;
+}
+
+const char *host_primitive_name(HostPrimitive primitive) {
+    return primitive < HOST_PRIM_COUNT ? s_primitive_names[primitive] : "?";
+}
+
+// Plot a pixel in layer coordinates, clipped to the current layer
+static void plot(GContext *ctx, int x, int y, GColor color) {
+    if (!ctx->framebuffer || color.argb == GColorClear.argb) {
+        return;
+    }
+    x += ctx->offset.x;
+    y += ctx->offset.y;
+    if (x < ctx->clip.origin.x || y < ctx->clip.origin.y ||
+        x >= ctx->clip.origin.x + ctx->clip.size.w || y >= ctx->clip.origin.y + ctx->clip.size.h) {
+        return;
+    }
+    ctx->framebuffer[y * ctx->fb_size.w + x] = color;
+}
+
+static void fill_disc(GContext *ctx, int cx, int cy, int radius, GColor color) {
+    for (int dy = -radius; dy <= radius; dy++) {
+        for (int dx = -radius; dx <= radius; dx++) {
+            if (dx * dx + dy * dy <= radius * radius + radius) {
+                plot(ctx, cx + dx, cy + dy, color);
+            }
+        }
+    }
+}
+
+// Whether a pixel lies inside a rectangle with (optionally) rounded corners
+static bool in_round_rect(int x, int y, GRect rect, int radius, GCornerMask mask) {
+    int left = rect.origin.x;
+    int top = rect.origin.y;
+    int right = rect.origin.x + rect.size.w - 1;
+    int bottom = rect.origin.y + rect.size.h - 1;
+
+    if (x < left || x > right || y < top || y > bottom) {
+        return false;
+    }
+    if (radius <= 0) {
+        return true;
+    }
+
+    // Distance past the corner circle centre, if the pixel is in a rounded corner
+    int cx = 0;
+    int cy = 0;
+    GCornerMask corner = GCornerNone;
+    if (x < left + radius && y < top + radius) {
+        corner = GCornerTopLeft;
+        cx = left + radius - x;
+        cy = top + radius - y;
+    } else if (x > right - radius && y < top + radius) {
+        corner = GCornerTopRight;
+        cx = x - (right - radius);
+        cy = top + radius - y;
+    } else if (x < left + radius && y > bottom - radius) {
+        corner = GCornerBottomLeft;
+        cx = left + radius - x;
+        cy = y - (bottom - radius);
+    } else if (x > right - radius && y > bottom - radius) {
+        corner = GCornerBottomRight;
+        cx = x - (right - radius);
+        cy = y - (bottom - radius);
+    }
+
+    return !(mask & corner) || cx * cx + cy * cy <= radius * radius;
+}
+
+// ---------------------------------------------------------------------------
+// Drawing API
+// ---------------------------------------------------------------------------
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+    ctx->fill_color = color;
+}
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+    ctx->stroke_color = color;
+}
+
+void graphics_context_set_text_color(GContext *ctx, GColor color) {
+    ctx->text_color = color;
+}
+
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t width) {
+    ctx->stroke_width = width;
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+    ctx->counts[HOST_PRIM_FILL_RECT]++;
+    if (!ctx->framebuffer) {
+        return;
+    }
+    for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+        for (int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+            if (in_round_rect(x, y, rect, corner_radius, corner_mask)) {
+                plot(ctx, x, y, ctx->fill_color);
+            }
+        }
+    }
+}
+
+void graphics_fill_circle(GContext *ctx, GPoint center, uint16_t radius) {
+    ctx->counts[HOST_PRIM_FILL_CIRCLE]++;
+    fill_disc(ctx, center.x, center.y, radius, ctx->fill_color);
+}
+
+static void stroke_point(GContext *ctx, int x, int y, GColor color, int width) {
+    if (width <= 1) {
+        plot(ctx, x, y, color);
+    } else {
+        fill_disc(ctx, x, y, width / 2, color);
+    }
+}
+
+static bool in_disc(int dx, int dy, int radius) {
+    return dx * dx + dy * dy <= radius * radius + radius;
+}
+
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius) {
+    ctx->counts[HOST_PRIM_DRAW_CIRCLE]++;
+    if (!ctx->framebuffer) {
+        return;
+    }
+
+    // Outline: pixels inside the disc whose 4-neighbourhood leaves it
+    for (int dy = -radius; dy <= radius; dy++) {
+        for (int dx = -radius; dx <= radius; dx++) {
+            if (in_disc(dx, dy, radius) &&
+                (!in_disc(dx - 1, dy, radius) || !in_disc(dx + 1, dy, radius) ||
+                 !in_disc(dx, dy - 1, radius) || !in_disc(dx, dy + 1, radius))) {
+                stroke_point(ctx, p.x + dx, p.y + dy, ctx->stroke_color, ctx->stroke_width);
+            }
+        }
+    }
+}
+
+void graphics_draw_pixel(GContext *ctx, GPoint point) {
+    ctx->counts[HOST_PRIM_DRAW_PIXEL]++;
+    if (ctx->framebuffer) {
+        plot(ctx, point.x, point.y, ctx->stroke_color);
+    }
+}
+
+// Bresenham line
+static void stroke_line(GContext *ctx, GPoint p0, GPoint p1, GColor color, int width) {
+    int x = p0.x;
+    int y = p0.y;
+    int dx = abs(p1.x - p0.x);
+    int dy = -abs(p1.y - p0.y);
+    int sx = p0.x < p1.x ? 1 : -1;
+    int sy = p0.y < p1.y ? 1 : -1;
+    int err = dx + dy;
+
+    for (;;) {
+        stroke_point(ctx, x, y, color, width);
+        if (x == p1.x && y == p1.y) {
+            break;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+    ctx->counts[HOST_PRIM_DRAW_LINE]++;
+    if (ctx->framebuffer) {
+        stroke_line(ctx, p0, p1, ctx->stroke_color, ctx->stroke_width);
+    }
+}
+
+void graphics_draw_round_rect(GContext *ctx, GRect rect, uint16_t radius) {
+    ctx->counts[HOST_PRIM_DRAW_ROUND_RECT]++;
+    if (!ctx->framebuffer) {
+        return;
+    }
+
+    // Outline: pixels inside the shape whose 4-neighbourhood leaves it
+    for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+        for (int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+            if (in_round_rect(x, y, rect, radius, GCornersAll) &&
+                (!in_round_rect(x - 1, y, rect, radius, GCornersAll) ||
+                 !in_round_rect(x + 1, y, rect, radius, GCornersAll) ||
+                 !in_round_rect(x, y - 1, rect, radius, GCornersAll) ||
+                 !in_round_rect(x, y + 1, rect, radius, GCornersAll))) {
+                stroke_point(ctx, x, y, ctx->stroke_color, ctx->stroke_width);
+            }
+        }
+    }
+}
+
+void graphics_draw_arc(GContext *ctx, GRect rect, GOvalScaleMode scale_mode, int32_t angle_start, int32_t angle_end) {
+    ctx->counts[HOST_PRIM_DRAW_ARC]++;
+    if (!ctx->framebuffer) {
+        return;
+    }
+
+    // Trig angles start at 12 o'clock and run clockwise; sample every degree
+    int radius = (rect.size.w < rect.size.h ? rect.size.w : rect.size.h) / 2;
+    int cx = rect.origin.x + rect.size.w / 2;
+    int cy = rect.origin.y + rect.size.h / 2;
+    int32_t step = TRIG_MAX_ANGLE / 360;
+
+    for (int32_t angle = angle_start; angle <= angle_end; angle += step) {
+        double radians = (double)angle * 2.0 * 3.14159265358979 / TRIG_MAX_ANGLE;
+        int x = cx + (int)(radius * sin(radians) + (radius * sin(radians) >= 0 ? 0.5 : -0.5));
+        int y = cy - (int)(radius * cos(radians) + (radius * cos(radians) >= 0 ? 0.5 : -0.5));
+        stroke_point(ctx, x, y, ctx->stroke_color, ctx->stroke_width);
+    }
+}
+
+GPath *gpath_create(const GPathInfo *init) {
+    GPath *path = host_heap_alloc(sizeof(GPath) + init->num_points * sizeof(GPoint));
+    path->num_points = init->num_points;
+    path->points = (GPoint *)(path + 1);
+    memcpy(path->points, init->points, init->num_points * sizeof(GPoint));
+    path->offset = GPoint(0, 0);
+    return path;
+}
+
+void gpath_destroy(GPath *path) {
+    host_heap_free(path);
+}
+
+void gpath_draw_filled(GContext *ctx, GPath *path) {
+    ctx->counts[HOST_PRIM_GPATH_FILLED]++;
+    if (!ctx->framebuffer || path->num_points < 3) {
+        return;
+    }
+
+    int min_y = path->points[0].y;
+    int max_y = path->points[0].y;
+    for (uint32_t i = 1; i < path->num_points; i++) {
+        if (path->points[i].y < min_y) min_y = path->points[i].y;
+        if (path->points[i].y > max_y) max_y = path->points[i].y;
+    }
+
+    // Even-odd scanline fill through pixel centres, plus the outline so thin shapes stay visible
+    for (int y = min_y; y <= max_y; y++) {
+        double crossings[16];
+        int count = 0;
+        for (uint32_t i = 0; i < path->num_points && count < 16; i++) {
+            GPoint a = path->points[i];
+            GPoint b = path->points[(i + 1) % path->num_points];
+            double scan = y + 0.5;
+            if ((a.y <= scan && b.y > scan) || (b.y <= scan && a.y > scan)) {
+                crossings[count++] = a.x + (scan - a.y) * (b.x - a.x) / (double)(b.y - a.y);
+            }
+        }
+        for (int i = 1; i < count; i++) {
+            for (int j = i; j > 0 && crossings[j - 1] > crossings[j]; j--) {
+                double swap = crossings[j];
+                crossings[j] = crossings[j - 1];
+                crossings[j - 1] = swap;
+            }
+        }
+        for (int i = 0; i + 1 < count; i += 2) {
+            for (int x = (int)(crossings[i] + 0.5); x <= (int)(crossings[i + 1] - 0.5); x++) {
+                plot(ctx, x + path->offset.x, y + path->offset.y, ctx->fill_color);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < path->num_points; i++) {
+        GPoint a = path->points[i];
+        GPoint b = path->points[(i + 1) % path->num_points];
+        stroke_line(ctx, GPoint(a.x + path->offset.x, a.y + path->offset.y),
+                    GPoint(b.x + path->offset.x, b.y + path->offset.y), ctx->fill_color, 1);
+    }
+}
+
+static void draw_glyph(GContext *ctx, char c, GFont font, int x, int y) {
+    if (c < 0x20 || c > 0x7E) {
+        c = '?';
+    }
+    const uint8_t *columns = s_glyphs[c - 0x20];
+    int scale = font->scale;
+
+    for (int col = 0; col < 5; col++) {
+        for (int row = 0; row < 8; row++) {
+            if (!(columns[col] & (1 << row))) {
+                continue;
+            }
+            for (int sy = 0; sy < scale; sy++) {
+                for (int sx = 0; sx < scale; sx++) {
+                    plot(ctx, x + col * scale + sx, y + row * scale + sy, ctx->text_color);
+                }
+            }
+        }
+    }
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+                        GTextOverflowMode overflow_mode, GTextAlignment alignment, void *text_attributes) {
+    ctx->counts[HOST_PRIM_DRAW_TEXT]++;
+    if (!ctx->framebuffer || !text) {
+        return;
+    }
+
+    // Clip to the text box as well as the layer
+    GRect saved_clip = ctx->clip;
+    int left = box.origin.x + ctx->offset.x;
+    int top = box.origin.y + ctx->offset.y;
+    int right = left + box.size.w;
+    int bottom = top + box.size.h;
+    if (left < ctx->clip.origin.x) left = ctx->clip.origin.x;
+    if (top < ctx->clip.origin.y) top = ctx->clip.origin.y;
+    if (right > ctx->clip.origin.x + ctx->clip.size.w) right = ctx->clip.origin.x + ctx->clip.size.w;
+    if (bottom > ctx->clip.origin.y + ctx->clip.size.h) bottom = ctx->clip.origin.y + ctx->clip.size.h;
+    ctx->clip = GRect(left, top, right > left ? right - left : 0, bottom > top ? bottom - top : 0);
+
+    // Glyphs sit roughly where the system fonts' cap height does
+    int y = box.origin.y + (font->height - 7 * font->scale + 2) / 2;
+    const char *line = text;
+    while (*line) {
+        int width = line_width(line, font);
+        int x = box.origin.x;
+        if (alignment == GTextAlignmentCenter) {
+            x += (box.size.w - width) / 2;
+        } else if (alignment == GTextAlignmentRight) {
+            x += box.size.w - width;
+        }
+
+        while (*line && *line != '\n') {
+            draw_glyph(ctx, *line, font, x, y);
+            x += glyph_advance(font);
+            line++;
+        }
+        if (*line == '\n') {
+            line++;
+        }
+        y += font->height;
+    }
+
+    ctx->clip = saved_clip;
+}
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+                                            GTextOverflowMode overflow_mode, GTextAlignment alignment) {
+    int w = 0;
+    int lines = 0;
+    for (const char *line = text; *line; ) {
+        int width = line_width(line, font);
+        if (width > w) {
+            w = width;
+        }
+        lines++;
+        line = strchr(line, '\n');
+        if (!line) {
+            break;
+        }
+        line++;
+    }
+
+    int h = lines * font->height;
+    return GSize(w < box.size.w ? w : box.size.w, h < box.size.h ? h : box.size.h);
+}
+
+// ---------------------------------------------------------------------------
+// Compositing
+// ---------------------------------------------------------------------------
+
+static void render_text_layer(TextLayer *text_layer, GContext *ctx) {
+    GRect bounds = layer_get_bounds(&text_layer->layer);
+    if (text_layer->background_color.argb != GColorClear.argb) {
+        ctx->fill_color = text_layer->background_color;
+        graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+    }
+    if (text_layer->text && text_layer->text[0]) {
+        ctx->text_color = text_layer->text_color;
+        graphics_draw_text(ctx, text_layer->text, text_layer->font, bounds,
+                           GTextOverflowModeTrailingEllipsis, text_layer->alignment, NULL);
+    }
+}
+
+static void render_bitmap_layer(BitmapLayer *bitmap_layer, GContext *ctx) {
+    const HostIcon *icon = bitmap_layer->bitmap ? find_icon(bitmap_layer->bitmap->resource_id) : NULL;
+    if (!icon) {
+        return;
+    }
+
+    // Only GAlignCenter is used by the app
+    GRect bounds = layer_get_bounds(&bitmap_layer->layer);
+    int x0 = (bounds.size.w - icon->width) / 2;
+    int y0 = (bounds.size.h - icon->height) / 2;
+
+    for (int y = 0; y < icon->height; y++) {
+        for (int x = 0; x < icon->width; x++) {
+            char pixel = icon->rows[y][x];
+            if (pixel == '.') {
+                continue;
+            }
+            bool white = pixel == '#';
+            // Or only adds white pixels, And only adds black ones
+            if ((bitmap_layer->compositing_mode == GCompOpOr && !white) ||
+                (bitmap_layer->compositing_mode == GCompOpAnd && white)) {
+                continue;
+            }
+            plot(ctx, x0 + x, y0 + y, white ? GColorWhite : GColorBlack);
+        }
+    }
+}
+
+static void render_layer(Layer *layer, GContext *ctx, GPoint origin, GRect clip) {
+    if (layer->hidden) {
+        return;
+    }
+
+    GPoint abs = GPoint(origin.x + layer->frame.origin.x, origin.y + layer->frame.origin.y);
+
+    // Children are clipped to their parent's frame
+    int left = abs.x > clip.origin.x ? abs.x : clip.origin.x;
+    int top = abs.y > clip.origin.y ? abs.y : clip.origin.y;
+    int right = abs.x + layer->frame.size.w;
+    int bottom = abs.y + layer->frame.size.h;
+    if (right > clip.origin.x + clip.size.w) right = clip.origin.x + clip.size.w;
+    if (bottom > clip.origin.y + clip.size.h) bottom = clip.origin.y + clip.size.h;
+    GRect layer_clip = GRect(left, top, right > left ? right - left : 0, bottom > top ? bottom - top : 0);
+
+    ctx->offset = abs;
+    ctx->clip = layer_clip;
+
+    if (layer->kind == HOST_LAYER_TEXT) {
+        render_text_layer((TextLayer *)layer, ctx);
+    } else if (layer->kind == HOST_LAYER_BITMAP) {
+        render_bitmap_layer((BitmapLayer *)layer, ctx);
+    } else if (layer->update_proc) {
+        layer->update_proc(layer, ctx);
+    }
+
+    for (Layer *child = layer->first_child; child; child = child->next_sibling) {
+        render_layer(child, ctx, abs, layer_clip);
+    }
+}
+
+void host_render_window(Window *window, GContext *ctx) {
+    if (ctx->framebuffer) {
+        for (int i = 0; i < ctx->fb_size.w * ctx->fb_size.h; i++) {
+            ctx->framebuffer[i] = window->background_color;
+        }
+    }
+    render_layer(&window->root_layer, ctx, GPoint(0, 0), GRect(0, 0, ctx->fb_size.w, ctx->fb_size.h));
+}
@@ -0,0 +1,584 @@
+/**
+ * T1000 CGM Watchface - Golden-image render tests
+ *
+ * Drives main.c through scripted scenarios, rasterizes the whole window with the
+ * host rasterizer (raster.c) and compares the frame against checked-in goldens.
+ * Primitive counts per frame (and vibrations) are reported alongside, with the
+ * change since the goldens were recorded.
+ *
+ *   render-bw [--update] [--out DIR] [SCENARIO...]
+ *
+ * Monochrome builds use PBM goldens; color builds use PGM goldens holding the raw
+ * GColor8 value of each pixel. Mismatching frames are written to --out as
+ * viewable PPMs (actual and diff).
+ */
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define main t1000_main
+#include "../../src/c/main.c"
+#undef main
+
+#if defined(PBL_PLATFORM_EMERY)
+#define VARIANT "emery"
+#elif defined(PBL_PLATFORM_CHALK)
+#define VARIANT "chalk"
+#elif defined(PBL_COLOR)
+#define VARIANT "color"
+#else
+#define VARIANT "bw"
+#endif
+
+#ifdef PBL_COLOR
+#define GOLDEN_EXT "pgm"
+#else
+#define GOLDEN_EXT "pbm"
+#endif
+
+#define GOLDEN_DIR "goldens/" VARIANT
+
+// Fixed wall clock so the time/date row is stable (Tue 14 Nov 2023, 22:13 UTC)
+#define SCENARIO_TIME 1700000000
+
+static const char *HISTORY_STEADY =
+    "142:2,140:7,139:12,141:17,144:22,147:27,150:32,152:37,151:42,149:47,146:52,143:57,"
+    "139:62,136:67,133:72,131:77,130:82,128:87,127:92,129:97,132:102,135:107,138:112,140:117";
+static const char *HISTORY_FALLING =
+    "39:1,44:6,52:11,61:16,70:21,79:26,88:31,97:36,105:41,112:46,118:51,123:56";
+static const char *HISTORY_RISING =
+    "401:3,388:8,371:13,352:18,330:23,309:28,287:33,266:38,245:43,226:48,210:53,196:58";
+
+typedef struct {
+    int32_t trend;
+    int32_t minutes_ago;
+    const char *history;
+    const char *meals;
+    int32_t reversed;
+    int32_t alert;
+    int32_t view;
+    const char *prediction;
+    const uint8_t *bands;
+    int32_t account_count;  // 0 = untagged (single account)
+    int32_t account;
+    const char *label;
+    int32_t mmol;
+    int32_t stale_alarm;
+} ScenarioMessage;
+
+static void write_account(DictionaryIterator *iter, const ScenarioMessage *m) {
+    if (m->account_count) {
+        dict_write_int32(iter, KEY_ACCOUNT, m->account);
+        dict_write_int32(iter, KEY_ACCOUNT_COUNT, m->account_count);
+        dict_write_cstring(iter, KEY_ACCOUNT_LABEL, m->label);
+    }
+}
+
+// Alert message as sent by sendAlert() in index.js
+static void deliver_alert(const ScenarioMessage *m, int32_t alert_id) {
+    static uint8_t buffer[128];
+    DictionaryIterator iter;
+    host_dict_init(&iter, buffer, sizeof(buffer));
+    dict_write_int32(&iter, KEY_CGM_ALERT, m->alert);
+    dict_write_int32(&iter, KEY_ALERT_ID, alert_id);
+    write_account(&iter, m);
+    inbox_received_callback(&iter, NULL);
+}
+
+// Reading message as sent by processReadings() in index.js (an alert goes ahead of it)
+static void deliver(const ScenarioMessage *m) {
+    static int32_t s_alert_id = 0;
+    if (m->alert != ALERT_NONE) {
+        deliver_alert(m, ++s_alert_id);
+    }
+
+    static uint8_t buffer[512];
+    DictionaryIterator iter;
+    host_dict_init(&iter, buffer, sizeof(buffer));
+    dict_write_int32(&iter, KEY_CGM_TREND, m->trend);
+    dict_write_int32(&iter, KEY_CGM_TIME_AGO, m->minutes_ago);
+    dict_write_cstring(&iter, KEY_CGM_HISTORY, m->history);
+    dict_write_int32(&iter, KEY_LOW_THRESHOLD, 70);
+    dict_write_int32(&iter, KEY_HIGH_THRESHOLD, 180);
+    dict_write_int32(&iter, KEY_REVERSED, m->reversed);
+    dict_write_int32(&iter, KEY_UNIT, m->mmol);
+    dict_write_int32(&iter, KEY_STALE_ALARM, m->stale_alarm);
+    dict_write_int32(&iter, KEY_NEEDS_SETUP, 0);
+    dict_write_int32(&iter, KEY_SYNC_ERROR, 0);
+    dict_write_cstring(&iter, KEY_MEAL_DATA, m->meals ? m->meals : "");
+    dict_write_int32(&iter, KEY_DEFAULT_VIEW, m->view);
+    dict_write_cstring(&iter, KEY_PREDICTION, m->prediction ? m->prediction : "");
+    if (m->bands) {
+        dict_write_data(&iter, KEY_BANDS, m->bands, BAND_HOURS * BAND_PERCENTILES);
+    }
+    write_account(&iter, m);
+    inbox_received_callback(&iter, NULL);
+}
+
+// Error message as sent by sendError() in index.js
+static void deliver_error(bool needs_setup) {
+    static uint8_t buffer[128];
+    DictionaryIterator iter;
+    host_dict_init(&iter, buffer, sizeof(buffer));
+    dict_write_int32(&iter, KEY_CGM_VALUE, 0);
+    dict_write_int32(&iter, KEY_CGM_TREND, TREND_HIDE);
+    dict_write_int32(&iter, KEY_CGM_TIME_AGO, 0);
+    dict_write_int32(&iter, KEY_NEEDS_SETUP, needs_setup);
+    dict_write_int32(&iter, KEY_SYNC_ERROR, !needs_setup);
+    inbox_received_callback(&iter, NULL);
+}
+
+// Let the clock run: timers fire, and the minute tick runs once per elapsed minute
+static void advance_minutes(int minutes) {
+    for (int i = 0; i < minutes; i++) {
+        host_set_time(time(NULL) + 60);
+        host_run_timers(60000);
+        tick_handler(NULL, MINUTE_UNIT);
+    }
+}
+
+static void scenario_loading(void) {
+}
+
+static void scenario_setup(void) {
+    deliver_error(true);
+}
+
+static void scenario_normal(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE });
+}
+
+static void scenario_reversed(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 1, ALERT_NONE });
+}
+
+static void scenario_low(void) {
+    deliver(&(ScenarioMessage) { TREND_DOUBLE_DOWN, 1, HISTORY_FALLING, NULL, 0, ALERT_LOW_SOON });
+}
+
+static void scenario_high(void) {
+    deliver(&(ScenarioMessage) { TREND_DOUBLE_UP, 3, HISTORY_RISING, NULL, 0, ALERT_HIGH });
+}
+
+static void scenario_meals(void) {
+    deliver(&(ScenarioMessage) { TREND_UP_45, 2, HISTORY_STEADY, "45:15,12:60,30:100", 0, ALERT_NONE });
+}
+
+static void scenario_future_meals(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, "25:-10,40:30", 0, ALERT_NONE });
+}
+
+static void scenario_stale(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE });
+    advance_minutes(65);
+}
+
+// Phone unreachable: data requests and their retry fail once the reading is 15+ minutes old
+static void scenario_offline(void) {
+    deliver(&(ScenarioMessage) { TREND_DOWN_45, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE });
+    advance_minutes(16);
+
+    // The data request and its retry both fail
+    static uint8_t buffer[16];
+    DictionaryIterator iter;
+    host_dict_init(&iter, buffer, sizeof(buffer));
+    dict_write_uint8(&iter, KEY_REQUEST_DATA, 1);
+    outbox_failed_callback(&iter, APP_MSG_SEND_TIMEOUT, NULL);
+    outbox_failed_callback(&iter, APP_MSG_SEND_TIMEOUT, NULL);
+}
+
+static void scenario_prediction(void) {
+    deliver(&(ScenarioMessage) { TREND_DOWN_45, 2, HISTORY_STEADY, "25:-10", 0, ALERT_NONE, VIEW_CHART,
+                                 "138:-3,133:-8,128:-13,122:-18,117:-23,111:-28" });
+}
+
+// Typical range peaking in the evening (p10/p25/p75/p90 = mid -/+ 45/20 mg/dL)
+static void scenario_bands(void) {
+    static const int16_t middle[BAND_HOURS] = {
+        120, 115, 110, 110, 115, 125, 140, 160, 170, 160, 145, 135,
+        150, 165, 160, 145, 135, 130, 150, 175, 190, 180, 160, 135
+    };
+    static uint8_t bands[BAND_HOURS * BAND_PERCENTILES];
+    for (int h = 0; h < BAND_HOURS; h++) {
+        bands[h * 4 + 0] = (uint8_t)((middle[h] - 45) / 2);
+        bands[h * 4 + 1] = (uint8_t)((middle[h] - 20) / 2);
+        bands[h * 4 + 2] = (uint8_t)((middle[h] + 20) / 2);
+        bands[h * 4 + 3] = (uint8_t)((middle[h] + 45) / 2);
+    }
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE, VIEW_CHART,
+                                 "141:-3,140:-8,139:-13,138:-18,137:-23,136:-28", bands });
+}
+
+// A day of readings every 5 minutes (a slow swing between ~60 and ~240)
+static void deliver_day_of_readings(int32_t view) {
+    static const int16_t swing[] = { 150, 185, 215, 235, 240, 225, 195, 160, 125, 95, 72, 60, 65, 85, 115 };
+    char history[16];
+    for (int i = 0; i < 288; i++) {
+        advance_minutes(5);
+        snprintf(history, sizeof(history), "%d:0", swing[(i / 6) % ARRAY_LENGTH(swing)]);
+        deliver(&(ScenarioMessage) { TREND_FLAT, 0, history, NULL, 0, ALERT_NONE, view });
+    }
+}
+
+// A day of readings, then the watchface is restarted so the statistics come back
+// from persistent storage
+static void scenario_stats(void) {
+    deliver_day_of_readings(VIEW_STATS);
+    deinit();
+    init();
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE, VIEW_STATS });
+}
+
+// Following two accounts, then taps go from the main one's chart through its
+// long-range chart and statistics to the second
+static void scenario_followers(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, "45:15", 0, ALERT_NONE, VIEW_CHART,
+                                 NULL, NULL, 2, 0, "Alex" });
+    deliver(&(ScenarioMessage) { TREND_DOWN, 1,
+                                 "97:1,106:6,114:11,121:16,127:21,132:26,136:31,139:36,141:41,142:46", NULL, 0, ALERT_NONE, VIEW_CHART,
+                                 "88:-4,79:-9,70:-14", NULL, 2, 1, "Sam" });
+    for (int i = 0; i < 3; i++) {
+        accel_tap_handler(ACCEL_AXIS_Y, 1);
+    }
+}
+
+// A day of readings, then a tap shows the long-range chart
+static void scenario_long_view(void) {
+    deliver_day_of_readings(VIEW_CHART);
+    accel_tap_handler(ACCEL_AXIS_Y, 1);
+}
+
+// Taps to the statistics, which go back to the default chart after the timeout
+static void scenario_view_revert(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE });
+    accel_tap_handler(ACCEL_AXIS_Y, 1);
+    accel_tap_handler(ACCEL_AXIS_Y, 1);
+    host_run_timers(VIEW_REVERT_MS);
+}
+
+// The phone goes quiet after repeating the same reading; the watch's own alarm
+// goes off once that reading is 30 minutes old
+static void scenario_stale_alarm(void) {
+    deliver(&(ScenarioMessage) { TREND_FLAT, 2, HISTORY_STEADY, NULL, 0, ALERT_NONE, VIEW_CHART,
+                                 NULL, NULL, 0, 0, NULL, 0, 30 });
+    advance_minutes(10);
+    deliver(&(ScenarioMessage) { TREND_FLAT, 12, HISTORY_STEADY, NULL, 0, ALERT_NONE, VIEW_CHART,
+                                 NULL, NULL, 0, 0, NULL, 0, 30 });
+    advance_minutes(20);
+}
+
+// The watch's ack is lost, so the phone resends the alert; it only vibrates once
+static void scenario_alert_resend(void) {
+    ScenarioMessage message = { TREND_DOUBLE_DOWN, 1, HISTORY_FALLING, NULL, 0, ALERT_LOW_SOON };
+    deliver(&message);
+    deliver_alert(&message, 1);
+}
+
+// No trend from the source: the arrow and the (mmol/L) delta come from the history
+static void scenario_derived_trend(void) {
+    deliver(&(ScenarioMessage) { TREND_NONE, 1,
+                                 "118:1,127:6,133:11,138:16,141:21,143:26,144:31,144:36,143:41,141:46", NULL, 0, ALERT_NONE,
+                                 VIEW_CHART, NULL, NULL, 0, 0, NULL, 1 });
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} Scenario;
+
+static const Scenario SCENARIOS[] = {
+    { "loading", scenario_loading },
+    { "setup", scenario_setup },
+    { "normal", scenario_normal },
+    { "reversed", scenario_reversed },
+    { "low", scenario_low },
+    { "high", scenario_high },
+    { "meals", scenario_meals },
+    { "future_meals", scenario_future_meals },
+    { "stale", scenario_stale },
+    { "offline", scenario_offline },
+    { "prediction", scenario_prediction },
+    { "bands", scenario_bands },
+    { "stats", scenario_stats },
+    { "followers", scenario_followers },
+    { "derived_trend", scenario_derived_trend },
+    { "long_view", scenario_long_view },
+    { "view_revert", scenario_view_revert },
+    { "stale_alarm", scenario_stale_alarm },
+    { "alert_resend", scenario_alert_resend },
+};
+
+// ---------------------------------------------------------------------------
+// Image files
+// ---------------------------------------------------------------------------
+
+static void color_to_rgb(GColor8 color, uint8_t rgb[3]) {
+    // GColor8 is 2 bits per channel: aarrggbb
+    rgb[0] = ((color.argb >> 4) & 3) * 85;
+    rgb[1] = ((color.argb >> 2) & 3) * 85;
+    rgb[2] = (color.argb & 3) * 85;
+}
+
+#ifndef PBL_COLOR
+static bool is_white(GColor8 color) {
+    uint8_t rgb[3];
+    color_to_rgb(color, rgb);
+    return rgb[0] + rgb[1] + rgb[2] >= 384;
+}
+#endif
+
+// Encode a frame in the golden format; returns the byte count
+static size_t encode_golden(const GColor8 *fb, GSize size, uint8_t *out, size_t capacity) {
+#ifdef PBL_COLOR
+    size_t len = (size_t)snprintf((char *)out, capacity, "P5\n%d %d\n255\n", size.w, size.h);
+    for (int i = 0; i < size.w * size.h; i++) {
+        out[len++] = fb[i].argb;
+    }
+#else
+    size_t len = (size_t)snprintf((char *)out, capacity, "P4\n%d %d\n", size.w, size.h);
+    int row_bytes = (size.w + 7) / 8;
+    for (int y = 0; y < size.h; y++) {
+        for (int b = 0; b < row_bytes; b++) {
+            uint8_t byte = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                int x = b * 8 + bit;
+                // PBM: 1 is black
+                if (x < size.w && !is_white(fb[y * size.w + x])) {
+                    byte |= 0x80 >> bit;
+                }
+            }
+            out[len++] = byte;
+        }
+    }
+#endif
+    return len;
+}
+
+static bool write_file(const char *path, const uint8_t *data, size_t len) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, len, file) == len;
+    return fclose(file) == 0 && ok;
+}
+
+static size_t read_file(const char *path, uint8_t *data, size_t capacity) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    size_t len = fread(data, 1, capacity, file);
+    fclose(file);
+    return len;
+}
+
+static void write_ppm(const char *path, const GColor8 *fb, GSize size, const uint8_t *highlight) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", size.w, size.h);
+    for (int i = 0; i < size.w * size.h; i++) {
+        uint8_t rgb[3];
+        color_to_rgb(fb[i], rgb);
+        if (highlight && highlight[i]) {
+            rgb[0] = 255;
+            rgb[1] = 0;
+            rgb[2] = 255;
+        }
+        fwrite(rgb, 1, 3, file);
+    }
+    fclose(file);
+}
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+// Primitive total recorded with the goldens, or -1
+static int recorded_total(const char *name) {
+    FILE *file = fopen(GOLDEN_DIR "/counts.txt", "r");
+    if (!file) {
+        return -1;
+    }
+    char line[256];
+    int total = -1;
+    while (fgets(line, sizeof(line), file)) {
+        char scenario[64];
+        int count;
+        if (sscanf(line, "%63s %d", scenario, &count) == 2 && strcmp(scenario, name) == 0) {
+            total = count;
+        }
+    }
+    fclose(file);
+    return total;
+}
+
+/**
+ * Run one scenario in this process and compare (or record) its frame
+ * Returns 0 on match, 1 on mismatch
+ */
+static int run_scenario(const Scenario *scenario, bool update, const char *out_dir, FILE *counts) {
+    setenv("TZ", "UTC", 1);
+    tzset();
+    host_set_time(SCENARIO_TIME);
+    init();
+    scenario->run();
+
+    // Let the sync spinner time out before the frame is captured
+    host_run_timers(1000);
+
+    GSize size = host_get_screen_size();
+    GColor8 *fb = calloc(size.w * size.h, sizeof(GColor8));
+    GContext ctx;
+    host_gcontext_init(&ctx);
+    host_gcontext_attach(&ctx, fb, size);
+    host_render_window(s_main_window, &ctx);
+
+    static uint8_t encoded[128 * 1024];
+    size_t encoded_len = encode_golden(fb, size, encoded, sizeof(encoded));
+    char golden_path[256];
+    snprintf(golden_path, sizeof(golden_path), GOLDEN_DIR "/%s." GOLDEN_EXT, scenario->name);
+
+    uint32_t total = host_gcontext_total(&ctx);
+    char breakdown[256] = "";
+    for (int i = 0; i < HOST_PRIM_TEXT_LAYOUT; i++) {
+        if (ctx.counts[i]) {
+            size_t used = strlen(breakdown);
+            snprintf(breakdown + used, sizeof(breakdown) - used, " %s=%u", host_primitive_name(i), ctx.counts[i]);
+        }
+    }
+    if (host_vibe_count()) {
+        size_t used = strlen(breakdown);
+        snprintf(breakdown + used, sizeof(breakdown) - used, " vibes=%u", host_vibe_count());
+    }
+
+    int result = 0;
+    if (update) {
+        write_file(golden_path, encoded, encoded_len);
+        fprintf(counts, "%s %u%s\n", scenario->name, total, breakdown);
+        printf("UPDATED  %-14s %3u primitives:%s\n", scenario->name, total, breakdown);
+    } else {
+        static uint8_t golden[128 * 1024];
+        size_t golden_len = read_file(golden_path, golden, sizeof(golden));
+        int recorded = recorded_total(scenario->name);
+        char delta[32] = "";
+        if (recorded >= 0 && recorded != (int)total) {
+            snprintf(delta, sizeof(delta), " (was %d)", recorded);
+        }
+
+        if (golden_len == encoded_len && memcmp(golden, encoded, encoded_len) == 0) {
+            printf("PASS     %-14s %3u primitives%s:%s\n", scenario->name, total, delta, breakdown);
+        } else {
+            result = 1;
+            char path[256];
+            snprintf(path, sizeof(path), "%s/%s.actual.ppm", out_dir, scenario->name);
+            write_ppm(path, fb, size, NULL);
+
+            // Diff against the golden if it decodes to the same size
+            int differing = -1;
+            if (golden_len == encoded_len) {
+                GColor8 *golden_fb = calloc(size.w * size.h, sizeof(GColor8));
+                uint8_t *mask = calloc(size.w * size.h, 1);
+#ifdef PBL_COLOR
+                size_t data_start = encoded_len - (size_t)(size.w * size.h);
+#else
+                size_t data_start = encoded_len - (size_t)(((size.w + 7) / 8) * size.h);
+#endif
+                differing = 0;
+                for (int y = 0; y < size.h; y++) {
+                    for (int x = 0; x < size.w; x++) {
+                        int i = y * size.w + x;
+#ifdef PBL_COLOR
+                        golden_fb[i].argb = golden[data_start + i];
+                        bool differs = golden_fb[i].argb != fb[i].argb;
+#else
+                        bool golden_black = golden[data_start + y * ((size.w + 7) / 8) + x / 8] & (0x80 >> (x % 8));
+                        golden_fb[i] = golden_black ? GColorBlack : GColorWhite;
+                        bool differs = golden_black == is_white(fb[i]);
+#endif
+                        mask[i] = differs;
+                        differing += differs;
+                    }
+                }
+                snprintf(path, sizeof(path), "%s/%s.diff.ppm", out_dir, scenario->name);
+                write_ppm(path, golden_fb, size, mask);
+                free(golden_fb);
+                free(mask);
+            }
+            if (differing < 0) {
+                printf("FAIL     %-14s missing or malformed golden %s\n", scenario->name, golden_path);
+            } else {
+                printf("FAIL     %-14s %d pixels differ, %3u primitives%s:%s\n",
+                       scenario->name, differing, total, delta, breakdown);
+            }
+        }
+    }
+
+    free(fb);
+    deinit();
+    return result;
+}
+
+int main(int argc, char **argv) {
+    bool update = false;
+    const char *out_dir = "render-out";
+    const char *only[32];
+    int only_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (only_count < 32) {
+            only[only_count++] = argv[i];
+        }
+    }
+
+    mkdir(out_dir, 0755);
+    FILE *counts = update ? fopen(GOLDEN_DIR "/counts.txt", "w") : NULL;
+    if (update && !counts) {
+        fprintf(stderr, "Cannot write %s/counts.txt\n", GOLDEN_DIR);
+        return 1;
+    }
+
+    int failures = 0;
+    int run = 0;
+    for (size_t i = 0; i < ARRAY_LENGTH(SCENARIOS); i++) {
+        bool selected = only_count == 0;
+        for (int j = 0; j < only_count; j++) {
+            selected |= strcmp(only[j], SCENARIOS[i].name) == 0;
+        }
+        if (!selected) {
+            continue;
+        }
+        run++;
+
+        // main.c keeps its state in statics, so each scenario gets a fresh process
+        fflush(stdout);
+        if (counts) {
+            fflush(counts);
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            exit(run_scenario(&SCENARIOS[i], update, out_dir, counts));
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            if (!WIFEXITED(status)) {
+                printf("CRASH    %s\n", SCENARIOS[i].name);
+            }
+            failures++;
+        }
+    }
+
+    if (counts) {
+        fclose(counts);
+    }
+    printf("%s: %d/%d scenarios %s\n", VARIANT, run - failures, run, update ? "recorded" : "match");
+    return failures ? 1 : 0;
+}
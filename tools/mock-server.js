@@ -0,0 +1,144 @@
+#!/usr/bin/env node
+/**
+ * T1000 CGM Watchface - Local mock glucose server
+ *
+ * Replays a recorded trace through stand-ins for the Dexcom Share and Nightscout
+ * endpoints used by src/pkjs/sources.js, with configurable upload latency,
+ * response delay and error rates, so polling and caching can be exercised offline.
+ *
+ * Usage:
+ *   node tools/mock-server.js [--port 8080] [--trace tools/traces/sample.csv]
+ *     [--start-minute 120] [--upload-delay 60] [--response-delay 200]
+ *     [--error-rate 0] [--auth-error-rate 0]
+ *
+ * Point the Nightscout data source at http://<host>:<port> to use it from a phone.
+ * GET /stats returns request counts.
+ */
+
+var httpServer = require("http");
+var path = require("path");
+var url = require("url");
+var Trace = require("./trace");
+
+var DEFAULTS = {
+	port: 8080,
+	trace: path.join(__dirname, "traces", "sample.csv"),
+	"start-minute": 120, // Trace minute that corresponds to server start
+	"upload-delay": 60, // Seconds after its timestamp before a reading is served
+	"response-delay": 200, // Milliseconds before each response is sent
+	"error-rate": 0, // Fraction of requests failing with HTTP 503
+	"auth-error-rate": 0 // Fraction of logins failing with HTTP 500 (Dexcom's bad-credentials status)
+};
+
+/**
+ * Parse --name value pairs over the defaults
+ */
+function parseArgs(argv) {
+	var options = {};
+	for (var key in DEFAULTS) {
+		options[key] = DEFAULTS[key];
+	}
+	for (var i = 0; i < argv.length; i++) {
+		var match = argv[i].match(/^--(.+)$/);
+		if (match && options.hasOwnProperty(match[1]) && i + 1 < argv.length) {
+			var value = argv[++i];
+			options[match[1]] = typeof DEFAULTS[match[1]] === "number" ? parseFloat(value) : value;
+		}
+	}
+	return options;
+}
+
+var options = parseArgs(process.argv.slice(2));
+var trace = Trace.loadTrace(options.trace);
+var origin = Date.now() - options["start-minute"] * 60000;
+var stats = { login: 0, dexcomReadings: 0, nightscoutEntries: 0, errors: 0, readingsServed: 0 };
+
+/**
+ * Readings visible to clients right now (most recent first)
+ */
+function visibleReadings(minutes, count) {
+	var visibleUntil = Date.now() - options["upload-delay"] * 1000;
+	var readings = Trace.readingsBetween(trace, origin, Date.now() - minutes * 60000, visibleUntil);
+	return readings.slice(0, count);
+}
+
+function send(res, status, body) {
+	setTimeout(function () {
+		res.writeHead(status, { "Content-Type": "application/json" });
+		res.end(typeof body === "string" ? body : JSON.stringify(body));
+	}, options["response-delay"]);
+}
+
+var server = httpServer.createServer(function (req, res) {
+	var parsed = url.parse(req.url, true);
+	var pathname = parsed.pathname;
+	var query = parsed.query;
+	console.log(req.method + " " + req.url);
+
+	if (pathname === "/stats") {
+		send(res, 200, stats);
+		return;
+	}
+
+	if (Math.random() < options["error-rate"]) {
+		stats.errors++;
+		send(res, 503, { message: "Simulated outage" });
+		return;
+	}
+
+	if (pathname === "/ShareWebServices/Services/General/LoginPublisherAccountByName") {
+		stats.login++;
+		if (Math.random() < options["auth-error-rate"]) {
+			stats.errors++;
+			send(res, 500, { Code: "AccountPasswordInvalid", Message: "Simulated auth failure" });
+			return;
+		}
+		send(res, 200, JSON.stringify("mock-session-" + stats.login));
+		return;
+	}
+
+	if (pathname === "/ShareWebServices/Services/Publisher/ReadPublisherLatestGlucoseValues") {
+		stats.dexcomReadings++;
+		var dexcom = visibleReadings(parseInt(query.minutes, 10) || 1440, parseInt(query.maxCount, 10) || 1);
+		stats.readingsServed += dexcom.length;
+		send(
+			res,
+			200,
+			dexcom.map(function (r) {
+				var date = "/Date(" + r.time + ")/";
+				return { WT: date, ST: date, DT: date, Value: r.value, Trend: r.trend };
+			})
+		);
+		return;
+	}
+
+	if (pathname === "/api/v1/entries/sgv.json" || pathname === "/api/v1/entries.json") {
+		stats.nightscoutEntries++;
+		var since = parseInt(query["find[date][$gt]"], 10) || Date.now() - 1440 * 60000;
+		var minutes = Math.max(0, (Date.now() - since) / 60000);
+		var entries = visibleReadings(minutes, parseInt(query.count, 10) || 10);
+		stats.readingsServed += entries.length;
+		send(
+			res,
+			200,
+			entries.map(function (r) {
+				return { type: "sgv", date: r.time, sgv: r.value, direction: r.trend };
+			})
+		);
+		return;
+	}
+
+	send(res, 404, { message: "Not found" });
+});
+
+server.listen(options.port, function () {
+	console.log(
+		"Mock glucose server on port " +
+			options.port +
+			" (" +
+			trace.entries.length +
+			" trace entries, upload delay " +
+			options["upload-delay"] +
+			"s)"
+	);
+});
@@ -0,0 +1,571 @@
+#!/usr/bin/env node
+/**
+ * T1000 CGM Watchface - Headless replay harness
+ *
+ * Loads src/pkjs/index.js in a sandbox with stubbed Pebble, XMLHttpRequest,
+ * localStorage and timers driven by a virtual clock, replays a recorded trace
+ * through an in-process stand-in for the glucose APIs, and reports HTTP requests,
+ * AppMessages, bytes, displayed-data staleness and alert timing. The alerts the
+ * watch received are compared with Alerts.replay() over every trace reading.
+ *
+ * Usage:
+ *   node tools/replay.js [--trace tools/traces/sample.csv] [--hours 24]
+ *     [--source dexcom|nightscout] [--platform basalt] [--upload-delay 60] [--upload-jitter 30]
+ *     [--response-delay 500] [--error-rate 0] [--message-drop-rate 0] [--watch-requests 1]
+ *     [--settings '{"vibeEnabled":true}'] [--meals 45:90,30:400] [--seed 1]
+ *     [--dump-messages messages.jsonl] [--json 0] [--verbose 0]
+ */
+
+var fs = require("fs");
+var path = require("path");
+var vm = require("vm");
+var Trace = require("./trace");
+
+var PKJS_DIR = path.join(__dirname, "..", "src", "pkjs");
+var Alerts = require(path.join(PKJS_DIR, "alerts"));
+var ClayConfig = require(path.join(PKJS_DIR, "config"));
+
+var DEFAULTS = {
+	trace: path.join(__dirname, "traces", "sample.csv"),
+	hours: 24,
+	source: "dexcom",
+	platform: "basalt", // Watch platform reported by Pebble.getActiveWatchInfo()
+	"start-minute": 120, // Trace minute at the start of the replay (history before it is available)
+	"upload-delay": 60, // Seconds between a reading's timestamp and it appearing on the server
+	"upload-jitter": 30, // Extra random upload delay, 0..jitter seconds
+	"response-delay": 500, // Milliseconds per HTTP response
+	"error-rate": 0, // Fraction of HTTP requests failing with 503
+	"message-drop-rate": 0, // Fraction of AppMessages the watch never gets (the send fails)
+	"watch-requests": 1, // Simulate the watch's once-a-minute KEY_REQUEST_DATA when data is 4+ min old
+	settings: "{}",
+	meals: "", // carbs:minute pairs served by the Saltie stand-in (minutes from the start of the replay)
+	seed: 1,
+	"dump-messages": "", // Write every AppMessage sent to the watch as a JSON line
+	json: 0,
+	verbose: 0
+};
+
+// AppMessage keys used by the report (must match index.js)
+var KEY_CGM_TIME_AGO = 3;
+var KEY_CGM_ALERT = 5;
+var KEY_REQUEST_DATA = 6;
+var KEY_SYNC_ERROR = 11;
+var KEY_ACCOUNT = 16;
+var KEY_ALERT_ID = 21;
+
+/**
+ * Parse --name value pairs over the defaults
+ */
+function parseArgs(argv) {
+	var options = {};
+	for (var key in DEFAULTS) {
+		options[key] = DEFAULTS[key];
+	}
+	for (var i = 0; i < argv.length; i++) {
+		var match = argv[i].match(/^--(.+)$/);
+		if (match && options.hasOwnProperty(match[1]) && i + 1 < argv.length) {
+			var value = argv[++i];
+			options[match[1]] = typeof DEFAULTS[match[1]] === "number" ? parseFloat(value) : value;
+		}
+	}
+	return options;
+}
+
+/**
+ * Small deterministic PRNG (mulberry32) so runs are reproducible
+ */
+function createRandom(seed) {
+	var state = seed >>> 0;
+	return function () {
+		state = (state + 0x6d2b79f5) >>> 0;
+		var t = state;
+		t = Math.imul(t ^ (t >>> 15), t | 1);
+		t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+		return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+	};
+}
+
+/**
+ * Virtual clock with a timer queue
+ */
+function VirtualClock(start) {
+	this.now = start;
+	this.timers = [];
+	this.nextId = 1;
+}
+
+VirtualClock.prototype.setTimeout = function (fn, delay) {
+	var id = this.nextId++;
+	this.timers.push({ id: id, time: this.now + Math.max(0, delay || 0), fn: fn });
+	return id;
+};
+
+VirtualClock.prototype.clearTimeout = function (id) {
+	this.timers = this.timers.filter(function (timer) {
+		return timer.id !== id;
+	});
+};
+
+/**
+ * Remove and return the earliest timer due at or before `until`
+ */
+VirtualClock.prototype.popNext = function (until) {
+	var best = -1;
+	for (var i = 0; i < this.timers.length; i++) {
+		var timer = this.timers[i];
+		if (timer.time <= until && (best < 0 || timer.time < this.timers[best].time)) {
+			best = i;
+		}
+	}
+	return best < 0 ? null : this.timers.splice(best, 1)[0];
+};
+
+/**
+ * Estimated AppMessage size: dictionary header plus 7 bytes per tuple and its data
+ */
+function appMessageBytes(message) {
+	var bytes = 1;
+	for (var key in message) {
+		var value = message[key];
+		if (typeof value === "string") {
+			bytes += 7 + Buffer.byteLength(value) + 1;
+		} else if (Array.isArray(value)) {
+			bytes += 7 + value.length; // Byte array
+		} else {
+			bytes += 7 + 4;
+		}
+	}
+	return bytes;
+}
+
+/**
+ * Parse "carbs:minute,..." into Saltie meals (eaten_at relative to the replay start)
+ */
+function parseMeals(spec, start) {
+	if (!spec) {
+		return [];
+	}
+	return spec.split(",").map(function (pair) {
+		var parts = pair.split(":");
+		return {
+			carbs_counted: parseFloat(parts[0]),
+			eaten_at: new Date(start + parseFloat(parts[1]) * 60000).toISOString()
+		};
+	});
+}
+
+/**
+ * Collect the settings page defaults (messageKey -> defaultValue)
+ */
+function clayDefaults(items, defaults) {
+	for (var i = 0; i < items.length; i++) {
+		if (items[i].messageKey) {
+			defaults[items[i].messageKey] = items[i].defaultValue;
+		}
+		if (items[i].items) {
+			clayDefaults(items[i].items, defaults);
+		}
+	}
+	return defaults;
+}
+
+/**
+ * Alerts the rules fire over every trace reading in the replay (history before the
+ * start warms up the predictor), with the replay's settings over the defaults
+ */
+function traceAlerts(trace, origin, start, end, overrides) {
+	var settings = clayDefaults(ClayConfig, {});
+	for (var key in overrides) {
+		settings[key] = overrides[key];
+	}
+	return Alerts.replay(settings, Trace.readingsBetween(trace, origin, origin, end)).filter(function (a) {
+		return a.time >= start;
+	});
+}
+
+function percentile(sorted, p) {
+	if (sorted.length === 0) {
+		return 0;
+	}
+	var index = Math.min(sorted.length - 1, Math.floor((p / 100) * sorted.length));
+	return sorted[index];
+}
+
+function run(options) {
+	var random = createRandom(options.seed);
+	var dropRandom = createRandom(options.seed + 1); // Separate, so drops don't shift the upload jitter
+	var start = Date.UTC(2024, 0, 1, 0, 0, 0);
+	var end = start + options.hours * 3600000;
+	var clock = new VirtualClock(start);
+	var trace = Trace.loadTrace(options.trace);
+	var origin = start - options["start-minute"] * 60000;
+	var meals = parseMeals(options.meals, start);
+	var dumpFd = options["dump-messages"] ? fs.openSync(options["dump-messages"], "w") : null;
+
+	var report = {
+		httpRequests: 0,
+		httpByEndpoint: {},
+		httpBytes: 0,
+		httpErrors: 0,
+		appMessages: 0,
+		appMessageBytes: 0,
+		largestAppMessage: 0,
+		errorMessages: 0,
+		droppedMessages: 0,
+		watchRequests: 0,
+		staleness: [],
+		alerts: [],
+		alertResends: 0,
+		traceAlerts: traceAlerts(trace, origin, start, end, JSON.parse(options.settings))
+	};
+
+	// Each reading becomes visible on the server after its own (jittered) upload delay
+	var uploadDelays = {};
+	function uploadDelayFor(time) {
+		if (uploadDelays[time] === undefined) {
+			uploadDelays[time] = (options["upload-delay"] + random() * options["upload-jitter"]) * 1000;
+		}
+		return uploadDelays[time];
+	}
+
+	function visibleReadings(minutes, count) {
+		var candidates = Trace.readingsBetween(trace, origin, clock.now - minutes * 60000, clock.now);
+		return candidates
+			.filter(function (r) {
+				return r.time + uploadDelayFor(r.time) <= clock.now;
+			})
+			.slice(0, count);
+	}
+
+	/**
+	 * In-process stand-in for the Dexcom Share / Nightscout endpoints (same as tools/mock-server.js)
+	 */
+	function handleRequest(method, requestUrl) {
+		var parsed = new URL(requestUrl);
+		var query = parsed.searchParams;
+		var endpoint = parsed.pathname.split("/").pop();
+		report.httpRequests++;
+		report.httpByEndpoint[endpoint] = (report.httpByEndpoint[endpoint] || 0) + 1;
+
+		if (random() < options["error-rate"]) {
+			report.httpErrors++;
+			return { status: 503, body: "{}" };
+		}
+		if (endpoint === "LoginPublisherAccountByName") {
+			return { status: 200, body: JSON.stringify("replay-session") };
+		}
+		if (endpoint === "ReadPublisherLatestGlucoseValues") {
+			var readings = visibleReadings(parseInt(query.get("minutes"), 10), parseInt(query.get("maxCount"), 10));
+			return {
+				status: 200,
+				body: JSON.stringify(
+					readings.map(function (r) {
+						var date = "/Date(" + r.time + ")/";
+						return { WT: date, ST: date, DT: date, Value: r.value, Trend: r.trend };
+					})
+				)
+			};
+		}
+		if (endpoint === "sgv.json") {
+			var since = parseInt(query.get("find[date][$gt]"), 10);
+			var entries = visibleReadings((clock.now - since) / 60000, parseInt(query.get("count"), 10));
+			return {
+				status: 200,
+				body: JSON.stringify(
+					entries.map(function (r) {
+						return { type: "sgv", date: r.time, sgv: r.value, direction: r.trend };
+					})
+				)
+			};
+		}
+		if (endpoint === "today") {
+			return { status: 200, body: JSON.stringify(meals) };
+		}
+		return { status: 404, body: "{}" };
+	}
+
+	function FakeXMLHttpRequest() {
+		this.status = 0;
+		this.statusText = "";
+		this.responseText = "";
+	}
+	FakeXMLHttpRequest.prototype.open = function (method, requestUrl) {
+		this.method = method;
+		this.url = requestUrl;
+	};
+	FakeXMLHttpRequest.prototype.setRequestHeader = function () {};
+	FakeXMLHttpRequest.prototype.send = function () {
+		var xhr = this;
+		clock.setTimeout(function () {
+			var response = handleRequest(xhr.method, xhr.url);
+			xhr.status = response.status;
+			xhr.statusText = response.status === 200 ? "OK" : "Error";
+			xhr.responseText = response.body;
+			report.httpBytes += Buffer.byteLength(response.body);
+			xhr.onload();
+		}, options["response-delay"]);
+	};
+
+	// Date whose now() and no-argument constructor follow the virtual clock
+	var RealDate = Date;
+	function VirtualDate() {
+		var args = Array.prototype.slice.call(arguments);
+		if (args.length === 0) {
+			return new RealDate(clock.now);
+		}
+		return new (Function.prototype.bind.apply(RealDate, [null].concat(args)))();
+	}
+	VirtualDate.now = function () {
+		return clock.now;
+	};
+	VirtualDate.UTC = RealDate.UTC;
+	VirtualDate.parse = RealDate.parse;
+	VirtualDate.prototype = RealDate.prototype;
+
+	var storage = {};
+	var localStorage = {
+		getItem: function (key) {
+			return storage.hasOwnProperty(key) ? storage[key] : null;
+		},
+		setItem: function (key, value) {
+			storage[key] = String(value);
+		},
+		removeItem: function (key) {
+			delete storage[key];
+		}
+	};
+
+	// Watch-side view of the data: timestamp of the reading currently displayed, and
+	// the alert ids it has acked
+	var watchReadingTime = null;
+	var watchAlertIds = {};
+	var handlers = {};
+	var Pebble = {
+		addEventListener: function (name, fn) {
+			handlers[name] = fn;
+		},
+		sendAppMessage: function (message, onSuccess, onError) {
+			report.appMessages++;
+			var size = appMessageBytes(message);
+			report.appMessageBytes += size;
+			report.largestAppMessage = Math.max(report.largestAppMessage, size);
+			if (dumpFd !== null) {
+				fs.writeSync(dumpFd, JSON.stringify({ time: clock.now, message: message }) + "\n");
+			}
+			if (options["message-drop-rate"] && dropRandom() < options["message-drop-rate"]) {
+				report.droppedMessages++;
+				clock.setTimeout(function () {
+					(onError || function () {})({ data: { transactionId: 0 }, error: { message: "Dropped" } });
+				}, 100);
+				return;
+			}
+			if (message[KEY_SYNC_ERROR]) {
+				report.errorMessages++;
+			}
+			// Staleness is measured for the main account (followers replay the same trace)
+			var shown = !message[KEY_ACCOUNT] && !message[KEY_SYNC_ERROR];
+			if (shown && message[KEY_CGM_TIME_AGO] !== undefined && message[KEY_CGM_TIME_AGO] !== 0) {
+				watchReadingTime = clock.now - message[KEY_CGM_TIME_AGO] * 60000;
+			} else if (shown && message[KEY_CGM_TIME_AGO] === 0) {
+				watchReadingTime = clock.now;
+			}
+			// Alerts are acked by id; a resend of one already received only gets the ack again
+			var alertId = message[KEY_ALERT_ID];
+			if (message[KEY_CGM_ALERT] && !(alertId && watchAlertIds[alertId])) {
+				report.alerts.push({ time: clock.now, alert: message[KEY_CGM_ALERT] });
+			} else if (alertId) {
+				report.alertResends++;
+			}
+			if (alertId) {
+				watchAlertIds[alertId] = true;
+				clock.setTimeout(function () {
+					var payload = {};
+					payload[KEY_ALERT_ID] = alertId;
+					// A dropped ack leaves the phone resending
+					if (!options["message-drop-rate"] || dropRandom() >= options["message-drop-rate"]) {
+						handlers.appmessage({ payload: payload });
+					}
+				}, 200);
+			}
+			clock.setTimeout(onSuccess || function () {}, 100);
+		},
+		getActiveWatchInfo: function () {
+			return { platform: options.platform };
+		},
+		openURL: function () {}
+	};
+
+	function Clay() {}
+	Clay.prototype.generateUrl = function () {
+		return "";
+	};
+
+	var logs = options.verbose
+		? console
+		: {
+				log: function () {}
+		  };
+
+	var sandboxMath = Object.create(Math);
+	sandboxMath.random = random;
+
+	var context = vm.createContext({
+		console: logs,
+		Date: VirtualDate,
+		Math: sandboxMath,
+		setTimeout: clock.setTimeout.bind(clock),
+		clearTimeout: clock.clearTimeout.bind(clock),
+		XMLHttpRequest: FakeXMLHttpRequest,
+		localStorage: localStorage,
+		Pebble: Pebble,
+		Promise: Promise,
+		JSON: JSON
+	});
+
+	// Minimal CommonJS loader running modules inside the sandbox
+	var moduleCache = {};
+	function requireFrom(dir) {
+		return function (name) {
+			if (name === "pebble-clay") {
+				return Clay;
+			}
+			var file = path.resolve(dir, name.endsWith(".js") ? name : name + ".js");
+			if (!moduleCache[file]) {
+				var module = { exports: {} };
+				moduleCache[file] = module;
+				var wrapper = vm.runInContext(
+					"(function (require, module, exports) {" + fs.readFileSync(file, "utf8") + "\n})",
+					context,
+					{ filename: file }
+				);
+				wrapper(requireFrom(path.dirname(file)), module, module.exports);
+			}
+			return moduleCache[file].exports;
+		};
+	}
+
+	var settings = {
+		source: options.source,
+		accountName: "replay",
+		password: "replay",
+		nightscoutUrl: "http://replay.invalid"
+	};
+	var overrides = JSON.parse(options.settings);
+	for (var key in overrides) {
+		settings[key] = overrides[key];
+	}
+	localStorage.setItem("clay-settings", JSON.stringify(settings));
+
+	requireFrom(PKJS_DIR)("./index");
+
+	// Watch tick: once a minute, ask for data when the displayed reading is 4+ minutes old
+	function tick() {
+		if (watchReadingTime !== null) {
+			report.staleness.push((clock.now - watchReadingTime) / 60000);
+		}
+		if (options["watch-requests"] && (watchReadingTime === null || clock.now - watchReadingTime >= 4 * 60000)) {
+			report.watchRequests++;
+			var payload = {};
+			payload[KEY_REQUEST_DATA] = 1;
+			handlers.appmessage({ payload: payload });
+		}
+		clock.setTimeout(tick, 60000);
+	}
+
+	handlers.ready();
+	clock.setTimeout(tick, 60000);
+
+	function step() {
+		var timer = clock.popNext(end);
+		if (!timer) {
+			clock.now = end;
+			if (dumpFd !== null) {
+				fs.closeSync(dumpFd);
+			}
+			return Promise.resolve(report);
+		}
+		clock.now = timer.time;
+		timer.fn();
+		// Let promise callbacks triggered by this timer run before the next one
+		return new Promise(function (resolve) {
+			setImmediate(resolve);
+		}).then(step);
+	}
+
+	return step();
+}
+
+function summarize(report, options) {
+	var staleness = report.staleness.slice().sort(function (a, b) {
+		return a - b;
+	});
+	return {
+		hours: options.hours,
+		httpRequests: report.httpRequests,
+		httpByEndpoint: report.httpByEndpoint,
+		httpBytes: report.httpBytes,
+		httpErrors: report.httpErrors,
+		appMessages: report.appMessages,
+		appMessageBytes: report.appMessageBytes,
+		largestAppMessage: report.largestAppMessage,
+		errorMessages: report.errorMessages,
+		droppedMessages: report.droppedMessages,
+		watchRequests: report.watchRequests,
+		stalenessMinutes: {
+			p50: percentile(staleness, 50),
+			p90: percentile(staleness, 90),
+			p99: percentile(staleness, 99),
+			max: staleness.length ? staleness[staleness.length - 1] : 0
+		},
+		alerts: alertMinutes(report.alerts),
+		alertResends: report.alertResends,
+		traceAlerts: alertMinutes(report.traceAlerts)
+	};
+}
+
+function alertMinutes(alerts) {
+	return alerts.map(function (a) {
+		return { minute: Math.round((a.time - Date.UTC(2024, 0, 1)) / 60000), alert: a.alert };
+	});
+}
+
+function formatAlerts(alerts) {
+	if (alerts.length === 0) {
+		return "none";
+	}
+	return alerts
+		.map(function (a) {
+			return (a.alert === Alerts.ALERT_LOW_SOON ? "low-soon" : "high") + "@" + a.minute + "m";
+		})
+		.join(", ");
+}
+
+var options = parseArgs(process.argv.slice(2));
+run(options).then(function (report) {
+	var summary = summarize(report, options);
+	if (options.json) {
+		console.log(JSON.stringify(summary, null, 2));
+		return;
+	}
+	console.log("Replayed " + summary.hours + "h of " + path.basename(options.trace) + " (" + options.source + ")");
+	console.log("HTTP requests:   " + summary.httpRequests + " " + JSON.stringify(summary.httpByEndpoint));
+	console.log("HTTP bytes:      " + summary.httpBytes + " (" + summary.httpErrors + " simulated errors)");
+	console.log("AppMessages:     " + summary.appMessages + " (" + summary.appMessageBytes + " bytes, largest " + summary.largestAppMessage + ", " + summary.errorMessages + " errors, " + summary.droppedMessages + " dropped)");
+	console.log("Watch requests:  " + summary.watchRequests);
+	console.log(
+		"Staleness (min): p50 " +
+			summary.stalenessMinutes.p50.toFixed(1) +
+			", p90 " +
+			summary.stalenessMinutes.p90.toFixed(1) +
+			", p99 " +
+			summary.stalenessMinutes.p99.toFixed(1) +
+			", max " +
+			summary.stalenessMinutes.max.toFixed(1)
+	);
+	console.log(
+		"Alerts:          " +
+			formatAlerts(summary.alerts) +
+			(summary.alertResends ? " (" + summary.alertResends + " resends)" : "")
+	);
+	console.log("Trace alerts:    " + formatAlerts(summary.traceAlerts));
+});
@@ -0,0 +1,71 @@
+/**
+ * T1000 CGM Watchface - Recorded glucose traces
+ *
+ * A trace is a CSV file of "minutes,mg/dL,trend" rows (minutes from the start of
+ * the trace, trend as a Dexcom trend name). Lines starting with # are comments.
+ * Traces repeat end to end, so a 24h trace can drive a replay of any length.
+ */
+
+var fs = require("fs");
+
+/**
+ * Load a trace file
+ * Returns { entries: [{ minute, value, trend }], durationMinutes }
+ */
+function loadTrace(path) {
+	var entries = [];
+	var lines = fs.readFileSync(path, "utf8").split(/\r?\n/);
+
+	for (var i = 0; i < lines.length; i++) {
+		var line = lines[i].trim();
+		if (!line || line.charAt(0) === "#") {
+			continue;
+		}
+		var fields = line.split(",");
+		entries.push({
+			minute: parseFloat(fields[0]),
+			value: parseInt(fields[1], 10),
+			trend: fields[2] || "None"
+		});
+	}
+
+	entries.sort(function (a, b) {
+		return a.minute - b.minute;
+	});
+
+	var last = entries.length > 0 ? entries[entries.length - 1].minute : 0;
+	// One reading interval after the last entry before the trace repeats
+	return { entries: entries, durationMinutes: last + 5 };
+}
+
+/**
+ * Readings with timestamps in (fromTime, toTime], most recent first
+ * origin is the wall-clock time (ms) of minute 0 of the first repetition
+ */
+function readingsBetween(trace, origin, fromTime, toTime) {
+	var readings = [];
+	if (trace.entries.length === 0 || toTime <= fromTime) {
+		return readings;
+	}
+
+	var cycleMs = trace.durationMinutes * 60000;
+	var firstCycle = Math.floor((fromTime - origin) / cycleMs);
+	var lastCycle = Math.floor((toTime - origin) / cycleMs);
+
+	for (var cycle = lastCycle; cycle >= firstCycle; cycle--) {
+		for (var i = trace.entries.length - 1; i >= 0; i--) {
+			var entry = trace.entries[i];
+			var time = origin + cycle * cycleMs + entry.minute * 60000;
+			if (time > fromTime && time <= toTime) {
+				readings.push({ time: time, value: entry.value, trend: entry.trend });
+			}
+		}
+	}
+
+	return readings;
+}
+
+module.exports = {
+	loadTrace: loadTrace,
+	readingsBetween: readingsBetween
+};